@@ -0,0 +1,25 @@
+#version 460 core
+
+layout(location = 0) out vec4 color;
+
+in vec4 v_Color;
+in vec2 v_TexCoord;
+in float v_TexSlot;         // Texture array layer
+
+// The array of the current batch is always bound to unit 1 (unit 0 holds the white texture)
+layout(binding = 1) uniform sampler2DArray u_TextureArray;
+
+#include "include/scene.glsl"
+
+void main() {
+
+    vec4 o_Color = u_Color * v_Color;
+
+    if (v_Color == vec4(0))
+        o_Color = u_Color;
+
+    color = texture(u_TextureArray, vec3(v_TexCoord, v_TexSlot)) * o_Color;
+
+    // Alpha channel handling
+    if(color.a < 0.1) discard;
+}
@@ -4,19 +4,21 @@ layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec2 a_TexCoord;
 layout(location = 2) in vec4 a_Color;
 layout(location = 3) in float a_TexSlot;
+layout(location = 4) in float a_Mode;
 
-uniform mat4 u_ViewProjection;
-uniform mat4 u_Transform;
+#include "include/scene.glsl"
 
 out vec4 v_Color;
 out vec2 v_TexCoord;
 out float v_TexSlot;
+out float v_Mode;
 
 void main() {
     
     v_TexCoord = a_TexCoord;
     v_Color = a_Color;
     v_TexSlot = a_TexSlot;
+    v_Mode = a_Mode;
 
     gl_Position = u_ViewProjection * u_Transform * vec4(a_Position, 1.0);
 }
@@ -4,12 +4,11 @@
 
 layout(location = 0) out vec4 color;
 
-uniform vec2 u_Resolution;
+#include "include/scene.glsl"
 
 uniform int u_CircleCount;
 uniform float u_Spacing;
 uniform float u_Radius;
-uniform vec4 u_Color;
 
 uniform float u_RunTime;
 
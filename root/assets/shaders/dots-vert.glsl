@@ -2,8 +2,7 @@
 
 layout(location = 0) in vec3 a_Position;
 
-uniform mat4 u_ViewProjection;
-uniform mat4 u_Transform;
+#include "include/scene.glsl"
 
 void main() {
     gl_Position = u_ViewProjection * u_Transform * vec4(a_Position, 1.0);
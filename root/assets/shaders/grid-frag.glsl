@@ -2,9 +2,9 @@
 
 layout(location = 0) out vec4 color;
 
-uniform vec2 u_Resolution;
+#include "include/scene.glsl"
+
 uniform vec3 u_CameraPosition;
-uniform vec4 u_Color;
 uniform float u_CellSize;
 
 // TODO: make these variables in
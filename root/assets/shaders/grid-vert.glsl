@@ -3,8 +3,7 @@
 // Position of grid rect is a constant, centered at 0, 0
 layout(location = 0) in vec3 a_Position;
 
-uniform mat4 u_ViewProjection;
-uniform mat4 u_Transform;
+#include "include/scene.glsl"
 
 void main() {
 
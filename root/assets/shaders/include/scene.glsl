@@ -0,0 +1,7 @@
+// Scene data, shared by every program and updated once per camera
+layout(std140, binding = 0) uniform Scene {
+    mat4 u_ViewProjection;
+    mat4 u_Transform;
+    vec4 u_Color;
+    vec2 u_Resolution;
+};
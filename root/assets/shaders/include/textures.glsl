@@ -0,0 +1,42 @@
+// Texture units of a batch. FLEET_MAX_TEXTURES is injected by the shader library from the device's unit count
+// and is always a multiple of 4.
+#ifndef FLEET_MAX_TEXTURES
+    #define FLEET_MAX_TEXTURES 16
+#endif
+
+layout(binding = 0) uniform sampler2D u_Textures[FLEET_MAX_TEXTURES];
+
+// Every unit gets its own case, sampling through int(v_TexSlot) directly creates artifacts
+#define FLEET_TEXTURE_CASE(i) case i: return texture(u_Textures[i], _uv);
+#define FLEET_TEXTURE_CASES(i) FLEET_TEXTURE_CASE(i) FLEET_TEXTURE_CASE(i + 1) FLEET_TEXTURE_CASE(i + 2) FLEET_TEXTURE_CASE(i + 3)
+
+vec4 SampleTexture(int _slot, vec2 _uv) {
+
+    switch (_slot) {
+
+        FLEET_TEXTURE_CASES(0)
+#if FLEET_MAX_TEXTURES > 4
+        FLEET_TEXTURE_CASES(4)
+#endif
+#if FLEET_MAX_TEXTURES > 8
+        FLEET_TEXTURE_CASES(8)
+#endif
+#if FLEET_MAX_TEXTURES > 12
+        FLEET_TEXTURE_CASES(12)
+#endif
+#if FLEET_MAX_TEXTURES > 16
+        FLEET_TEXTURE_CASES(16)
+#endif
+#if FLEET_MAX_TEXTURES > 20
+        FLEET_TEXTURE_CASES(20)
+#endif
+#if FLEET_MAX_TEXTURES > 24
+        FLEET_TEXTURE_CASES(24)
+#endif
+#if FLEET_MAX_TEXTURES > 28
+        FLEET_TEXTURE_CASES(28)
+#endif
+    }
+
+    return vec4(1.0);
+}
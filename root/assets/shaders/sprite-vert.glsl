@@ -0,0 +1,36 @@
+#version 460 core
+
+// Per instance sprite data, the quad corners are generated from gl_VertexID
+layout(location = 0) in vec3 i_Position;
+layout(location = 1) in vec2 i_Size;
+layout(location = 2) in float i_Rotation;
+layout(location = 3) in vec4 i_Color;
+layout(location = 4) in vec4 i_TexRect;
+layout(location = 5) in float i_TexSlot;
+
+#include "include/scene.glsl"
+
+out vec4 v_Color;
+out vec2 v_TexCoord;
+out float v_TexSlot;
+
+// Counter clockwise, bottom left to top left. Matches the quad index buffer.
+const vec2 Corners[4] = vec2[4](vec2(-0.5, -0.5), vec2(0.5, -0.5), vec2(0.5, 0.5), vec2(-0.5, 0.5));
+
+void main() {
+
+    vec2 corner = Corners[gl_VertexID] * i_Size;
+
+    float r = radians(i_Rotation);
+    float s = sin(r);
+    float c = cos(r);
+
+    vec2 rotated = vec2((corner.x * c) - (corner.y * s), (corner.x * s) + (corner.y * c));
+
+    // Texture rect is { u0, v0, u1, v1 }, atlas regions map to a sub rect of their page
+    v_TexCoord = mix(i_TexRect.xy, i_TexRect.zw, Corners[gl_VertexID] + 0.5);
+    v_Color = i_Color;
+    v_TexSlot = i_TexSlot;
+
+    gl_Position = u_ViewProjection * u_Transform * vec4(i_Position.xy + rotated, i_Position.z, 1.0);
+}
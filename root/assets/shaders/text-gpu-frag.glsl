@@ -0,0 +1,28 @@
+#version 460 core
+
+layout(location = 0) out vec4 color;
+
+in vec4 v_Color;
+in vec2 v_TexCoord;
+
+uniform bool u_SDF;
+
+#include "include/scene.glsl"
+
+layout(binding = 1) uniform sampler2D u_Font;
+
+void main() {
+
+    float alpha = texture(u_Font, v_TexCoord).r;
+
+    // Antialias over one screen pixel, whatever the scale
+    if (u_SDF) {
+        float w = max(fwidth(alpha), 0.0001);
+        alpha = smoothstep(0.5 - w, 0.5 + w, alpha);
+    }
+
+    color = vec4(1.0, 1.0, 1.0, alpha) * u_Color * v_Color;
+
+    // Alpha channel handling
+    if(color.a < 0.1) discard;
+}
@@ -0,0 +1,41 @@
+#version 460 core
+
+// Per glyph instance, the quad is built from the font's glyph table
+layout(location = 0) in vec3 i_Pen;
+layout(location = 1) in int i_Glyph;
+layout(location = 2) in int i_Color;
+layout(location = 3) in int i_Scale;
+
+struct Glyph {
+    vec4 quad;          // { bearing x, bearing y, width, height } in pixels
+    vec4 texrect;       // { u0, v0, u1, v1 }, v0 is the top row
+};
+
+layout(std430, binding = 0) readonly buffer Glyphs {
+    Glyph u_Glyphs[];
+};
+
+#include "include/scene.glsl"
+
+out vec4 v_Color;
+out vec2 v_TexCoord;
+
+// Counter clockwise, bottom left to top left. Matches the quad index buffer.
+const vec2 Corners[4] = vec2[4](vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0));
+
+void main() {
+
+    Glyph glyph = u_Glyphs[i_Glyph];
+
+    vec2 corner = Corners[gl_VertexID];
+    vec2 scale = unpackHalf2x16(uint(i_Scale));
+
+    // The bearing is measured from the pen to the top left of the glyph
+    vec2 BottomLeft = vec2(glyph.quad.x, glyph.quad.y - glyph.quad.w);
+    vec2 position = i_Pen.xy + (BottomLeft + corner * glyph.quad.zw) * scale;
+
+    v_TexCoord = vec2(mix(glyph.texrect.x, glyph.texrect.z, corner.x), mix(glyph.texrect.w, glyph.texrect.y, corner.y));
+    v_Color = unpackUnorm4x8(uint(i_Color));
+
+    gl_Position = u_ViewProjection * u_Transform * vec4(position, i_Pen.z, 1.0);
+}
@@ -5,8 +5,7 @@ layout(location = 1) in vec2 a_TexCoord;
 layout(location = 2) in vec4 a_Color;
 layout(location = 3) in float a_TexSlot;
 
-uniform mat4 u_ViewProjection;
-uniform mat4 u_Transform;
+#include "include/scene.glsl"
 
 out vec4 v_Color;
 out vec2 v_TexCoord;
@@ -18,7 +17,6 @@ void main() {
     v_Color = a_Color;
     v_TexSlot = a_TexSlot;
 
-    vec3 Position = vec3(a_Position.x,  -a_Position.y, a_Position.z);
-
-    gl_Position = u_ViewProjection * u_Transform * vec4(Position, 1.0);
+    // Text is laid out y up on the CPU
+    gl_Position = u_ViewProjection * u_Transform * vec4(a_Position, 1.0);
 }
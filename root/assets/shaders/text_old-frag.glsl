@@ -4,7 +4,8 @@ layout(location = 0) out vec4 color;
 
 in vec2 v_TexCoord;
 
-uniform vec4 u_Color;
+#include "include/scene.glsl"
+
 uniform sampler2D u_Texture;
 
 void main() {
@@ -3,8 +3,7 @@
 layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec2 a_TexCoord;
 
-uniform mat4 u_ViewProjection;
-uniform mat4 u_Transform;
+#include "include/scene.glsl"
 
 out vec2 v_TexCoord;
 
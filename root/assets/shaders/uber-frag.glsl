@@ -0,0 +1,68 @@
+#version 460 core
+
+// Quad fragment shader. The sampling modes are compiled in by the library entry:
+// FLEET_RGBA -> RGBA texture, FLEET_COVERAGE -> coverage glyph, FLEET_SDF -> signed distance field glyph.
+// With more than one mode, v_Mode picks per vertex. FLEET_DEBUG adds u_Debug, which draws the vertex color only.
+
+layout(location = 0) out vec4 color;
+
+in vec4 v_Color;
+in vec2 v_TexCoord;
+in float v_TexSlot;
+
+#if (defined(FLEET_RGBA) && (defined(FLEET_COVERAGE) || defined(FLEET_SDF))) || (defined(FLEET_COVERAGE) && defined(FLEET_SDF))
+    #define FLEET_MODES
+    in float v_Mode;
+#endif
+
+#ifdef FLEET_DEBUG
+    uniform bool u_Debug;
+#endif
+
+#include "include/scene.glsl"
+#include "include/textures.glsl"
+
+void main() {
+
+    vec4 o_Color = u_Color * v_Color;
+
+    if (v_Color == vec4(0))
+        o_Color = u_Color;
+
+    vec4 texel = SampleTexture(int(v_TexSlot), v_TexCoord);
+
+    // 0 -> RGBA texture, 1 -> coverage glyph, 2 -> signed distance field glyph. Single mode shaders fold the switch.
+#if defined(FLEET_MODES)
+    int mode = int(v_Mode + 0.5);
+#elif defined(FLEET_COVERAGE)
+    const int mode = 1;
+#elif defined(FLEET_SDF)
+    const int mode = 2;
+#else
+    const int mode = 0;
+#endif
+
+#ifdef FLEET_SDF
+    // Outside of the mode branches, derivatives need uniform control flow
+    float w = max(fwidth(texel.r), 0.0001);
+#endif
+
+    switch (mode) {
+
+#ifdef FLEET_COVERAGE
+        case 1: color = vec4(1.0, 1.0, 1.0, texel.r) * o_Color; break;
+#endif
+#ifdef FLEET_SDF
+        case 2: color = vec4(1.0, 1.0, 1.0, smoothstep(0.5 - w, 0.5 + w, texel.r)) * o_Color; break;
+#endif
+        default: color = texel * o_Color; break;
+    }
+
+#ifdef FLEET_DEBUG
+    if (u_Debug)
+        color = o_Color;
+#endif
+
+    // Alpha channel handling
+    if(color.a < 0.1) discard;
+}
@@ -0,0 +1,643 @@
+// Fleet : bench/bench.cpp (c) 2021 Andrew Woo
+
+/* Modified MIT License
+ *
+ * Copyright 2021 Andrew Woo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * Restrictions:
+ >  The Software may not be sold unless significant, mechanics changing modifications are made by the seller, or unless the buyer
+ >  understands an unmodified version of the Software is available elsewhere free of charge, and agrees to buy the Software given
+ >  this knowledge.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// fleet_bench drives standardized renderer scenes through an invisible window and reports
+// frames per second, CPU time per stage, GPU time, draw counts and allocations as JSON.
+//
+//  usage: fleet_bench [--frames N] [--warmup N] [--count N] [--text N] [--scene NAME] [--out PATH] [--fail-on-alloc]
+//
+// Run it from the directory holding assets/. Under Mesa llvmpipe without a display, run it inside a
+// virtual framebuffer (xvfb-run) or force the software driver with LIBGL_ALWAYS_SOFTWARE=1.
+
+#include <new>
+#include <cmath>
+#include <chrono>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+
+// Engine
+#include "../engine/engine.hpp"
+#include "../engine/manager.hpp"
+
+#include "../engine/graphics/manager.hpp"
+#include "../engine/graphics/renderer.hpp"
+#include "../engine/graphics/statistics.hpp"
+#include "../engine/graphics/profiler.hpp"
+
+// Game
+#include "../game/game.hpp"
+
+// Dependencies
+#include <ASWL/logger.hpp>
+
+using namespace Fleet::Core::Graphics::Renderer::RENDER_LAYER;
+
+// Allocation counter, every heap allocation in the process goes through here. All replaceable forms are
+// replaced (array, nothrow and aligned), so none of them can allocate past the count.
+static std::atomic<uint64_t> allocations { 0 };
+
+static void* Allocate(std::size_t _size) noexcept {
+
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(_size ? _size : 1);
+}
+static void* AllocateAligned(std::size_t _size, std::align_val_t _alignment) noexcept {
+
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    std::size_t alignment = static_cast<std::size_t>(_alignment);
+
+#ifdef _WIN32
+    return _aligned_malloc(_size ? _size : 1, alignment);
+#else
+    // aligned_alloc wants a multiple of the alignment
+    return std::aligned_alloc(alignment, ((_size ? _size : 1) + alignment - 1) / alignment * alignment);
+#endif
+}
+static void FreeAligned(void* _ptr) noexcept {
+
+#ifdef _WIN32
+    _aligned_free(_ptr);
+#else
+    std::free(_ptr);
+#endif
+}
+
+void* operator new(std::size_t _size) {
+
+    if (void* ptr = Allocate(_size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t _size) {
+
+    if (void* ptr = Allocate(_size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t _size, const std::nothrow_t&) noexcept {
+    return Allocate(_size);
+}
+void* operator new[](std::size_t _size, const std::nothrow_t&) noexcept {
+    return Allocate(_size);
+}
+
+void* operator new(std::size_t _size, std::align_val_t _alignment) {
+
+    if (void* ptr = AllocateAligned(_size, _alignment))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t _size, std::align_val_t _alignment) {
+
+    if (void* ptr = AllocateAligned(_size, _alignment))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t _size, std::align_val_t _alignment, const std::nothrow_t&) noexcept {
+    return AllocateAligned(_size, _alignment);
+}
+void* operator new[](std::size_t _size, std::align_val_t _alignment, const std::nothrow_t&) noexcept {
+    return AllocateAligned(_size, _alignment);
+}
+
+void operator delete(void* _ptr) noexcept {
+    std::free(_ptr);
+}
+void operator delete[](void* _ptr) noexcept {
+    std::free(_ptr);
+}
+void operator delete(void* _ptr, std::size_t) noexcept {
+    std::free(_ptr);
+}
+void operator delete[](void* _ptr, std::size_t) noexcept {
+    std::free(_ptr);
+}
+void operator delete(void* _ptr, const std::nothrow_t&) noexcept {
+    std::free(_ptr);
+}
+void operator delete[](void* _ptr, const std::nothrow_t&) noexcept {
+    std::free(_ptr);
+}
+
+void operator delete(void* _ptr, std::align_val_t) noexcept {
+    FreeAligned(_ptr);
+}
+void operator delete[](void* _ptr, std::align_val_t) noexcept {
+    FreeAligned(_ptr);
+}
+void operator delete(void* _ptr, std::size_t, std::align_val_t) noexcept {
+    FreeAligned(_ptr);
+}
+void operator delete[](void* _ptr, std::size_t, std::align_val_t) noexcept {
+    FreeAligned(_ptr);
+}
+void operator delete(void* _ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    FreeAligned(_ptr);
+}
+void operator delete[](void* _ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    FreeAligned(_ptr);
+}
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        int frames = 600;
+        int warmup = 256;           // Covers the layout cache eviction periods, text_glyphs only stops allocating after
+        int count = 10000;          // Sprites per frame
+        int text = 500;             // Text strings per frame
+        std::string scene;          // Run a single scene
+        std::string out;            // JSON output path, stdout if empty
+        bool FailOnAlloc = false;   // Exit with an error if any scene allocates in its steady state
+    };
+
+    struct Scene {
+        const char* name;
+        const char* camera;         // nullptr -> submit starts and ends its own scenes
+        const char* shader;
+        std::function<void(int)> submit;
+    };
+
+    struct Result {
+
+        std::string name;
+        int frames = 0;
+        double seconds = 0;
+
+        // CPU milliseconds per stage, summed over all frames
+        double update = 0;
+        double submit = 0;
+        double end = 0;
+        double present = 0;
+
+        // GPU milliseconds, summed over the resolved frames
+        double GPUFrame = 0;
+        double GPUScene = 0;
+        int GPUFrames = 0;
+
+        Fleet::Core::Graphics::Statistics::Counters counters;
+        uint64_t allocations = 0;
+    };
+
+    class Recorders {
+
+        /// Worker threads that record once per frame. They are started once, so a frame measures recording and
+        /// not thread creation, and waking them doesn't allocate.
+
+    public:
+
+        Recorders(int _count, std::function<void(int, int)> _record) : record(std::move(_record)) {
+
+            for (int i = 0; i < _count; i++)
+                threads.emplace_back(&Recorders::Work, this, i);
+        }
+        ~Recorders() {
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stop = true;
+            }
+
+            start.notify_all();
+
+            for (auto& thread : threads)
+                thread.join();
+        }
+
+        // Runs record(worker, frame) on every worker and waits for all of them
+        void Record(int _frame) {
+
+            std::unique_lock<std::mutex> lock(mutex);
+
+            frame = _frame;
+            pending = static_cast<int>(threads.size());
+            generation++;
+
+            start.notify_all();
+            done.wait(lock, [this] { return pending == 0; });
+        }
+
+        const int GetCount() const {
+            return static_cast<int>(threads.size());
+        }
+
+    private:
+
+        void Work(int _index) {
+
+            uint64_t seen = 0;
+
+            while (true) {
+
+                int __frame = 0;
+
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    start.wait(lock, [&] { return stop || generation != seen; });
+
+                    if (stop)
+                        return;
+
+                    seen = generation;
+                    __frame = frame;
+                }
+
+                record(_index, __frame);
+
+                std::lock_guard<std::mutex> lock(mutex);
+
+                if (--pending == 0)
+                    done.notify_one();
+            }
+        }
+
+        std::function<void(int, int)> record;
+        std::vector<std::thread> threads;
+
+        std::mutex mutex;
+        std::condition_variable start;
+        std::condition_variable done;
+
+        uint64_t generation = 0;
+        int frame = 0;
+        int pending = 0;
+        bool stop = false;
+    };
+
+    double Milliseconds(Clock::duration _duration) {
+        return std::chrono::duration<double, std::milli>(_duration).count();
+    }
+
+    Options ParseOptions(int argc, char* argv[]) {
+
+        Options options;
+
+        for (int i = 1; i < argc; i++) {
+
+            std::string arg = argv[i];
+            bool value = i + 1 < argc;
+
+            if (arg == "--frames" && value)
+                options.frames = std::atoi(argv[++i]);
+            else if (arg == "--warmup" && value)
+                options.warmup = std::atoi(argv[++i]);
+            else if (arg == "--count" && value)
+                options.count = std::atoi(argv[++i]);
+            else if (arg == "--text" && value)
+                options.text = std::atoi(argv[++i]);
+            else if (arg == "--scene" && value)
+                options.scene = argv[++i];
+            else if (arg == "--out" && value)
+                options.out = argv[++i];
+            else if (arg == "--fail-on-alloc")
+                options.FailOnAlloc = true;
+            else
+                ASWL::Logger::logger("BENCH", "Warning: Unknown argument [", arg, "].");
+        }
+
+        return options;
+    }
+
+    Result Run(Fleet::Core::Manager& _manager, const Scene& _scene, const Options& _options) {
+
+        namespace Graphics = Fleet::Core::Graphics;
+
+        Result result;
+        result.name = _scene.name;
+
+        namespace Renderer = Graphics::Renderer;
+
+        const auto& camera = _manager.GetCamera(_scene.camera ? _scene.camera : "main_0");
+        uint64_t LastGPUFrame = Graphics::Profiler::GetLastFrame().frame;
+
+        for (int frame = 0; frame < _options.warmup + _options.frames; frame++) {
+
+            bool measured = frame >= _options.warmup;
+            uint64_t AllocationsBefore = allocations.load(std::memory_order_relaxed);
+
+            auto t0 = Clock::now();
+            _manager.update();
+
+            Graphics::Manager::BeginRender();
+
+            auto t1 = Clock::now();
+            if (_scene.camera)
+                Renderer::StartScene(camera, _scene.shader);
+            _scene.submit(frame);
+
+            auto t2 = Clock::now();
+            if (_scene.camera)
+                Renderer::EndScene();
+
+            auto t3 = Clock::now();
+            Graphics::Manager::EndRender(_manager.GetWindow());
+
+            auto t4 = Clock::now();
+
+            if (!measured)
+                continue;
+
+            result.frames++;
+            result.update += Milliseconds(t1 - t0);
+            result.submit += Milliseconds(t2 - t1);
+            result.end += Milliseconds(t3 - t2);
+            result.present += Milliseconds(t4 - t3);
+            result.seconds += std::chrono::duration<double>(t4 - t0).count();
+
+            result.allocations += allocations.load(std::memory_order_relaxed) - AllocationsBefore;
+
+            const auto& counters = Graphics::Statistics::GetCurrentFrame().total;
+            result.counters.DrawCalls += counters.DrawCalls;
+            result.counters.Flushes += counters.Flushes;
+            result.counters.Quads += counters.Quads;
+            result.counters.Sprites += counters.Sprites;
+            result.counters.TextureBinds += counters.TextureBinds;
+            result.counters.ShaderBinds += counters.ShaderBinds;
+            result.counters.SkippedBinds += counters.SkippedBinds;
+            result.counters.BytesUploaded += counters.BytesUploaded;
+
+            // GPU results lag a few frames behind, count each resolved frame once
+            const auto& timing = Graphics::Profiler::GetLastFrame();
+
+            if (timing.frame != LastGPUFrame) {
+
+                LastGPUFrame = timing.frame;
+
+                result.GPUFrames++;
+                result.GPUFrame += timing.ms;
+
+                if (!timing.scenes.empty())
+                    result.GPUScene += timing.scenes.front().ms;
+            }
+        }
+
+        return result;
+    }
+
+    void Report(std::FILE* _file, const std::vector<Result>& _results, const Options& _options) {
+
+        auto renderer = reinterpret_cast<const char*>(glad_glGetString(GL_RENDERER));
+        auto version = reinterpret_cast<const char*>(glad_glGetString(GL_VERSION));
+
+        std::fprintf(_file, "{\n");
+        std::fprintf(_file, "  \"renderer\": \"%s\",\n", renderer ? renderer : "");
+        std::fprintf(_file, "  \"version\": \"%s\",\n", version ? version : "");
+        std::fprintf(_file, "  \"frames\": %d,\n", _options.frames);
+        std::fprintf(_file, "  \"count\": %d,\n", _options.count);
+        std::fprintf(_file, "  \"text\": %d,\n", _options.text);
+        std::fprintf(_file, "  \"scenes\": [\n");
+
+        for (size_t i = 0; i < _results.size(); i++) {
+
+            const Result& r = _results[i];
+
+            double frames = r.frames > 0 ? r.frames : 1;
+            double GPUFrames = r.GPUFrames > 0 ? r.GPUFrames : 1;
+
+            std::fprintf(_file, "    {\n");
+            std::fprintf(_file, "      \"name\": \"%s\",\n", r.name.c_str());
+            std::fprintf(_file, "      \"fps\": %.2f,\n", r.seconds > 0 ? r.frames / r.seconds : 0.0);
+            std::fprintf(_file, "      \"cpu_ms\": { \"update\": %.4f, \"submit\": %.4f, \"end_scene\": %.4f, \"present\": %.4f, \"frame\": %.4f },\n",
+                         r.update / frames, r.submit / frames, r.end / frames, r.present / frames, r.seconds * 1000.0 / frames);
+            std::fprintf(_file, "      \"gpu_ms\": { \"frame\": %.4f, \"scene\": %.4f, \"samples\": %d },\n",
+                         r.GPUFrame / GPUFrames, r.GPUScene / GPUFrames, r.GPUFrames);
+            std::fprintf(_file, "      \"draw_calls\": %.2f,\n", r.counters.DrawCalls / frames);
+            std::fprintf(_file, "      \"flushes\": %.2f,\n", r.counters.Flushes / frames);
+            std::fprintf(_file, "      \"quads\": %.2f,\n", r.counters.Quads / frames);
+            std::fprintf(_file, "      \"sprites\": %.2f,\n", r.counters.Sprites / frames);
+            std::fprintf(_file, "      \"texture_binds\": %.2f,\n", r.counters.TextureBinds / frames);
+            std::fprintf(_file, "      \"shader_binds\": %.2f,\n", r.counters.ShaderBinds / frames);
+            std::fprintf(_file, "      \"skipped_binds\": %.2f,\n", r.counters.SkippedBinds / frames);
+            std::fprintf(_file, "      \"bytes_uploaded\": %.0f,\n", r.counters.BytesUploaded / frames);
+            std::fprintf(_file, "      \"allocations_per_frame\": %.2f\n", r.allocations / frames);
+            std::fprintf(_file, "    }%s\n", (i + 1 < _results.size()) ? "," : "");
+        }
+
+        std::fprintf(_file, "  ]\n}\n");
+    }
+}
+
+int main(int argc, char* argv[]) {
+
+    namespace Renderer = Fleet::Core::Graphics::Renderer;
+
+    Options options = ParseOptions(argc, argv);
+
+    Fleet::Core::Manager manager;
+
+    if (manager.init(true) != 0) {
+        ASWL::Logger::logger("BENCH", "Fatal Error: Failed to initialize game manager.");
+        return -1;
+    }
+
+    std::shared_ptr<Fleet::Core::Graphics::Texture> texture = std::make_shared<Fleet::Core::Graphics::Texture>("assets/boat1.png");
+    const std::shared_ptr<Fleet::Core::Graphics::Font>& font = manager.GetFont("nsjpl", 25);
+
+    // The default font is only SDF when FreeType supports it
+    const char* TextShader = (font->GetMode() == Fleet::Core::Graphics::FontMode::SDF) ? "text_sdf" : "text";
+
+    // Sprites are laid out on a fixed grid covering the window, so every run draws the same thing
+    const glm::vec2 window = manager.GetWindowDimensions();
+
+    std::vector<glm::vec3> positions(options.count);
+    int columns = std::max(1, static_cast<int>(std::sqrt(static_cast<float>(options.count))));
+
+    for (int i = 0; i < options.count; i++) {
+
+        float x = (static_cast<float>(i % columns) / columns - 0.5f) * window.x;
+        float y = (static_cast<float>(i / columns) / columns - 0.5f) * window.y;
+
+        positions[i] = { x, y, LAYER0 + 0.0001f * (i % 100) };
+    }
+
+    std::vector<std::string> strings(options.text);
+    for (int i = 0; i < options.text; i++)
+        strings[i] = "00000000 Fleet bench string " + std::to_string(i);
+
+    const glm::vec2 scale = { 0.05f, 0.05f };
+
+    // Every worker records its share of the sprites into its own arena, the GL thread only submits them
+    const int workers = std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 2, 8);
+
+    std::vector<Renderer::CommandArena> arenas;
+    arenas.reserve(workers);
+
+    for (int i = 0; i < workers; i++)
+        arenas.emplace_back(static_cast<size_t>(options.count / workers + 1));
+
+    Recorders recorders(workers, [&](int _worker, int _frame) {
+
+        Renderer::CommandArena& arena = arenas[_worker];
+        arena.clear();
+
+        for (size_t i = _worker; i < positions.size(); i += workers)
+            arena.RenderTexture({ positions[i], scale, glm::vec4(1.f), static_cast<float>((i * 7 + _frame) % 360) }, texture);
+    });
+
+    // Arenas past the sort entry's 8 bit arena index, or commands past its 24 bit command index, can't be drawn
+    bool PackingExceeded = false;
+
+    // main.cpp's game, its frame is driven by the main_loop scene
+    Fleet::Game game(manager);
+
+    std::vector<Scene> scenes = {
+
+        { "sprites", "main_0", "basic", [&](int) {
+            for (const auto& position : positions)
+                Renderer::RenderTexture({ position, scale, glm::vec4(1.f) }, texture);
+        } },
+
+        { "rotated_sprites", "main_0", "basic", [&](int frame) {
+            for (size_t i = 0; i < positions.size(); i++)
+                Renderer::RenderTexture({ positions[i], scale, glm::vec4(1.f), static_cast<float>((i * 7 + frame) % 360) }, texture);
+        } },
+
+        { "instanced_sprites", "main_0", "sprite", [&](int frame) {
+            for (size_t i = 0; i < positions.size(); i++)
+                Renderer::RenderSprite({ positions[i], scale, glm::vec4(1.f), static_cast<float>((i * 7 + frame) % 360) }, texture);
+        } },
+
+        { "text", "text_0", TextShader, [&](int) {
+            for (size_t i = 0; i < strings.size(); i++) {
+                float y = (static_cast<float>(i % 40) / 40.f - 0.5f) * window.y;
+                float x = (static_cast<float>(i / 40 % 4) / 4.f - 0.5f) * window.x;
+                Renderer::RenderText(strings[i], { { x, y, LAYER1 }, { 1.f, 1.f }, glm::vec4(1.f) }, font);
+            }
+        } },
+
+        // Text that changes every frame, misses the layout cache and measures glyph lookup and layout throughput
+        { "text_glyphs", "text_0", TextShader, [&](int frame) {
+            for (size_t i = 0; i < strings.size(); i++) {
+
+                char counter[16];
+                std::snprintf(counter, sizeof(counter), "%08d", frame);
+                std::copy(counter, counter + 8, strings[i].begin());
+
+                float y = (static_cast<float>(i % 40) / 40.f - 0.5f) * window.y;
+                float x = (static_cast<float>(i / 40 % 4) / 4.f - 0.5f) * window.x;
+                Renderer::RenderText(strings[i], { { x, y, LAYER1 }, { 1.f, 1.f }, glm::vec4(1.f) }, font);
+            }
+        } },
+
+        // Same workload as text_glyphs, laid out on the CPU but expanded into quads by the text_gpu shader
+        { "text_gpu", "text_0", TextShader, [&](int frame) {
+            for (size_t i = 0; i < strings.size(); i++) {
+
+                char counter[16];
+                std::snprintf(counter, sizeof(counter), "%08d", frame);
+                std::copy(counter, counter + 8, strings[i].begin());
+
+                float y = (static_cast<float>(i % 40) / 40.f - 0.5f) * window.y;
+                float x = (static_cast<float>(i / 40 % 4) / 4.f - 0.5f) * window.x;
+                Renderer::RenderTextGPU(strings[i], { { x, y, LAYER1 }, { 1.f, 1.f }, glm::vec4(1.f) }, font);
+            }
+        } },
+
+        { "grid", "grid_0", "grid", [&](int) {
+            Renderer::RenderGrid(manager.GetCamera("main_0")->GetPosition(), 40);
+        } },
+
+        // Sprites recorded on worker threads into one arena each, then submitted on the GL thread
+        { "threaded_arenas", "main_0", "basic", [&](int frame) {
+
+            recorders.Record(frame);
+
+            // The renderer's own arena takes one slot
+            if (arenas.size() + 1 > Renderer::MaxArenas)
+                PackingExceeded = true;
+
+            for (const auto& arena : arenas) {
+
+                if (arena.GetQuads().size() > Renderer::MaxArenaCommands)
+                    PackingExceeded = true;
+
+                Renderer::Submit(arena);
+            }
+        } },
+
+        // main.cpp's frame itself, so the allocation check covers the real loop
+        { "main_loop", nullptr, nullptr, [&](int) {
+            game.frame();
+        } },
+    };
+
+    std::vector<Result> results;
+
+    for (const auto& scene : scenes) {
+
+        if (!options.scene.empty() && options.scene != scene.name)
+            continue;
+
+        results.push_back(Run(manager, scene, options));
+    }
+
+    std::FILE* file = options.out.empty() ? stdout : std::fopen(options.out.c_str(), "w");
+
+    if (!file) {
+        ASWL::Logger::logger("BENCH", "Error: Failed to open output file [", options.out, "].");
+        manager.shutdown();
+        return -1;
+    }
+
+    Report(file, results, options);
+
+    if (file != stdout)
+        std::fclose(file);
+
+    int ret = 0;
+
+    if (PackingExceeded) {
+        ASWL::Logger::logger("BENCH", "Error: Scene [threaded_arenas] exceeded the render queue's arena or command limits.");
+        ret = 1;
+    }
+
+    if (options.FailOnAlloc) {
+
+        for (const auto& result : results) {
+
+            if (result.allocations > 0) {
+                ASWL::Logger::logger("BENCH", "Error: Scene [", result.name, "] allocated ", result.allocations, " times in its steady state.");
+                ret = 1;
+            }
+        }
+    }
+
+    manager.shutdown();
+
+    return ret;
+}
@@ -0,0 +1,192 @@
+// Fleet : engine/cache.cpp (c) 2021 Andrew Woo
+
+/* Modified MIT License
+ *
+ * Copyright 2021 Andrew Woo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * Restrictions:
+ >  The Software may not be sold unless significant, mechanics changing modifications are made by the seller, or unless the buyer
+ >  understands an unmodified version of the Software is available elsewhere free of charge, and agrees to buy the Software given
+ >  this knowledge.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "cache.hpp"
+
+// Include standard library
+#include <cstdio>
+#include <fstream>
+#include <filesystem>
+#include <system_error>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+// Include dependencies
+#include <ASWL/logger.hpp>
+
+namespace Fleet::Core::Cache {
+
+    uint64_t Hash(const void* _data, size_t _size, uint64_t _seed) {
+
+        const unsigned char* bytes = static_cast<const unsigned char*>(_data);
+        uint64_t hash = _seed;
+
+        for (size_t i = 0; i < _size; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+    uint64_t Hash(const std::string& _string, uint64_t _seed) {
+        return Hash(_string.data(), _string.size(), _seed);
+    }
+
+    std::string Path(const std::string& _directory, const std::string& _name) {
+
+        std::filesystem::path directory = std::filesystem::path("cache") / _directory;
+
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+
+        return (directory / _name).string();
+    }
+
+    bool Write(const std::string& _path, const std::vector<unsigned char>& _data) {
+
+        std::string temporary = _path + ".tmp";
+
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+
+            if (!file.write(reinterpret_cast<const char*>(_data.data()), _data.size())) {
+                ASWL::Logger::logger("C0000", "Error: Failed to write cache file [", _path, "].");
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporary, _path, error);
+
+        if (error) {
+            ASWL::Logger::logger("C0000", "Error: Failed to write cache file [", _path, "].");
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+
+        return true;
+    }
+
+    // Mapped File
+    MappedFile::MappedFile(const std::string& _path) {
+        open(_path);
+    }
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    bool MappedFile::open(const std::string& _path) {
+
+        close();
+
+#ifdef _WIN32
+        HANDLE file = CreateFileA(_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER length;
+
+        if (!GetFileSizeEx(file, &length) || length.QuadPart == 0) {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+
+        if (!mapping)
+            return false;
+
+        // The view keeps the mapping alive
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+
+        if (!view)
+            return false;
+
+        data = static_cast<const unsigned char*>(view);
+        size = static_cast<size_t>(length.QuadPart);
+#else
+        int file = ::open(_path.c_str(), O_RDONLY);
+
+        if (file < 0)
+            return false;
+
+        struct stat status;
+
+        if (fstat(file, &status) != 0 || status.st_size == 0) {
+            ::close(file);
+            return false;
+        }
+
+        // The mapping stays valid after the descriptor is closed
+        void* view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        ::close(file);
+
+        if (view == MAP_FAILED)
+            return false;
+
+        data = static_cast<const unsigned char*>(view);
+        size = static_cast<size_t>(status.st_size);
+#endif
+
+        return true;
+    }
+
+    void MappedFile::close() {
+
+        if (!data)
+            return;
+
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+#else
+        munmap(const_cast<unsigned char*>(data), size);
+#endif
+
+        data = nullptr;
+        size = 0;
+    }
+
+    // Getters
+    const bool MappedFile::IsOpen() const {
+        return data != nullptr;
+    }
+    const unsigned char* MappedFile::GetData() const {
+        return data;
+    }
+    const size_t MappedFile::GetSize() const {
+        return size;
+    }
+}
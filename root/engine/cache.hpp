@@ -0,0 +1,84 @@
+// Fleet : engine/cache.hpp (c) 2021 Andrew Woo
+
+/* Modified MIT License
+ *
+ * Copyright 2021 Andrew Woo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * Restrictions:
+ >  The Software may not be sold unless significant, mechanics changing modifications are made by the seller, or unless the buyer
+ >  understands an unmodified version of the Software is available elsewhere free of charge, and agrees to buy the Software given
+ >  this knowledge.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#ifndef FLEET_ENGINE_CACHE
+#define FLEET_ENGINE_CACHE
+
+// Include standard library
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace Fleet::Core::Cache {
+
+    /*
+        Binary files derived from assets (font atlases, shader binaries) are
+        kept under cache/ next to the assets folder. Every entry is keyed by a
+        hash of whatever it was built from, so a stale entry is never read,
+        it simply stops being used.
+    */
+
+    constexpr uint64_t HashSeed = 14695981039346656037ull;
+
+    // FNV-1a, chain calls by passing the previous hash as the seed
+    uint64_t Hash(const void* _data, size_t _size, uint64_t _seed = HashSeed);
+    uint64_t Hash(const std::string& _string, uint64_t _seed = HashSeed);
+
+    // cache/<_directory>/<_name>, creates the directory
+    std::string Path(const std::string& _directory, const std::string& _name);
+
+    // Writes to a temporary file first, so a crash never leaves a partial entry behind
+    bool Write(const std::string& _path, const std::vector<unsigned char>& _data);
+
+    class MappedFile {
+
+        /// Read only memory mapping of a whole file
+
+    public:
+
+        MappedFile() = default;
+        MappedFile(const std::string& _path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool open(const std::string& _path);
+        void close();
+
+        // Getters
+        const bool IsOpen() const;
+        const unsigned char* GetData() const;
+        const size_t GetSize() const;
+
+    private:
+
+        const unsigned char* data = nullptr;
+        size_t size = 0;
+    };
+}
+
+#endif // !FLEET_ENGINE_CACHE
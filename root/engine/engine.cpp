@@ -88,14 +88,19 @@ namespace Fleet::Core {
         FramebufferDimensions = glm::vec2(width, height);
         glfwSwapInterval(metadata.enableVSync);
 
-        // Window Setup
-        const GLFWvidmode* mode = glfwGetVideoMode(glfwGetPrimaryMonitor());
-        int xPos = (mode->width - WindowDimensions.x) / 2;
-        int yPos = (mode->height - WindowDimensions.y) / 2;
-        glfwSetWindowPos(window, xPos, yPos);
+        // Window Setup (virtual framebuffers may not report a monitor)
+        const GLFWvidmode* mode = glfwGetPrimaryMonitor() ? glfwGetVideoMode(glfwGetPrimaryMonitor()) : nullptr;
+
+        if (mode) {
+            int xPos = (mode->width - WindowDimensions.x) / 2;
+            int yPos = (mode->height - WindowDimensions.y) / 2;
+            glfwSetWindowPos(window, xPos, yPos);
+        }
 
         // Full screen
-        if (metadata.vidmode == Metadata::VideoMode::FULLSCREEN) {
+        if (!mode || metadata.vidmode == Metadata::VideoMode::WINDOWED)
+            glfwSetWindowSizeLimits(window, WindowDimensions.x, WindowDimensions.y, WindowDimensions.x, WindowDimensions.y);
+        else if (metadata.vidmode == Metadata::VideoMode::FULLSCREEN) {
 
             glfwSetWindowMonitor(window, glfwGetPrimaryMonitor(), 0, 0, mode->width, mode->height, mode->refreshRate);
             SetWindowSize(mode->width, mode->height);
@@ -107,8 +112,6 @@ namespace Fleet::Core {
             SetWindowSize(mode->width, mode->height);
             glad_glViewport(0, 0, mode->width, mode->height);
         }
-        else // To be deprecated
-            glfwSetWindowSizeLimits(window, WindowDimensions.x, WindowDimensions.y, WindowDimensions.x, WindowDimensions.y);
 
         // Input Callback
         glfwSetCursorPosCallback(window, Fleet::Core::Input::Mouse::MousePositionCallback);
@@ -0,0 +1,256 @@
+// Fleet : engine/graphics/atlas.cpp (c) 2021 Andrew Woo
+
+/* Modified MIT License
+ *
+ * Copyright 2021 Andrew Woo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * Restrictions:
+ >  The Software may not be sold unless significant, mechanics changing modifications are made by the seller, or unless the buyer
+ >  understands an unmodified version of the Software is available elsewhere free of charge, and agrees to buy the Software given
+ >  this knowledge.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "atlas.hpp"
+
+// Include standard library
+#include <vector>
+#include <climits>
+#include <cstring>
+#include <algorithm>
+
+// Include dependencies
+#include <STB/stb_image.h>
+#include <ASWL/logger.hpp>
+
+namespace Fleet::Core::Graphics {
+
+    TextureAtlas::TextureAtlas(int _PageSize, int _padding) {
+
+        PageSize = _PageSize;
+        padding = _padding;
+    }
+
+    const std::shared_ptr<AtlasRegion>& TextureAtlas::Add(const std::string& _path) {
+
+        auto cached = regions.find(_path);
+        if (cached != regions.end())
+            return cached->second;
+
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+
+        // Same orientation as Texture, and always expanded to RGBA so every page shares one format
+        stbi_set_flip_vertically_on_load(true);
+        stbi_uc* data = stbi_load(_path.c_str(), &width, &height, &channels, 4);
+
+        if (!data) {
+            ASWL::Logger::logger("TA001", "Error: Failed to load image -> !stbi_load() [", _path, "].");
+            return empty;
+        }
+
+        const std::shared_ptr<AtlasRegion>& region = Add(_path, data, width, height);
+
+        stbi_image_free(data);
+
+        return region;
+    }
+
+    const std::shared_ptr<AtlasRegion>& TextureAtlas::Add(const std::string& _name, const void* _data, int _width, int _height) {
+
+        auto cached = regions.find(_name);
+        if (cached != regions.end())
+            return cached->second;
+
+        int width = _width + padding * 2;
+        int height = _height + padding * 2;
+
+        glm::ivec2 position;
+        Page* page = nullptr;
+
+        for (auto& p : pages) {
+            if (Pack(p, width, height, position)) {
+                page = &p;
+                break;
+            }
+        }
+
+        // Oversized images get a page of their own
+        if (!page) {
+
+            page = &CreatePage(std::max({ PageSize, width, height }));
+
+            if (!Pack(*page, width, height, position)) {
+                ASWL::Logger::logger("TA002", "Error: Failed to pack texture [", _name, "].");
+                return empty;
+            }
+        }
+
+        glm::vec2 offset = { position.x + padding, position.y + padding };
+        glm::vec2 size = { _width, _height };
+
+        // The padding repeats the image's edge texels, so filtering at the region's edge never reaches a neighbour
+        if (padding > 0) {
+
+            const uint8_t* src = static_cast<const uint8_t*>(_data);
+            std::vector<uint8_t> padded(static_cast<size_t>(width) * height * 4);
+
+            for (int y = 0; y < height; y++) {
+
+                const uint8_t* row = src + static_cast<size_t>(std::clamp(y - padding, 0, _height - 1)) * _width * 4;
+                uint8_t* dst = padded.data() + static_cast<size_t>(y) * width * 4;
+
+                for (int x = 0; x < padding; x++) {
+                    std::memcpy(dst + static_cast<size_t>(x) * 4, row, 4);
+                    std::memcpy(dst + static_cast<size_t>(padding + _width + x) * 4, row + static_cast<size_t>(_width - 1) * 4, 4);
+                }
+
+                std::memcpy(dst + static_cast<size_t>(padding) * 4, row, static_cast<size_t>(_width) * 4);
+            }
+
+            page->texture->SetSubData(padded.data(), glm::vec2(position.x, position.y), glm::vec2(width, height));
+        }
+        else
+            page->texture->SetSubData(_data, offset, size);
+
+        float s = static_cast<float>(page->size);
+
+        auto region = std::make_shared<AtlasRegion>();
+        region->page = page->texture;
+        region->dimensions = size;
+        region->TexRect = { offset.x / s, offset.y / s, (offset.x + size.x) / s, (offset.y + size.y) / s };
+        region->TexCoords = { glm::vec2(region->TexRect.x, region->TexRect.y),         // Bottom Left
+                              glm::vec2(region->TexRect.z, region->TexRect.y),         // Bottom Right
+                              glm::vec2(region->TexRect.z, region->TexRect.w),         // Top Right
+                              glm::vec2(region->TexRect.x, region->TexRect.w) };       // Top Left
+
+        return regions.insert({ _name, region }).first->second;
+    }
+
+    const std::shared_ptr<AtlasRegion>& TextureAtlas::Get(const std::string& _name) {
+
+        auto region = regions.find(_name);
+        return (region == regions.end()) ? empty : region->second;
+    }
+
+    const size_t TextureAtlas::GetPageCount() const {
+        return pages.size();
+    }
+    const int TextureAtlas::GetPageSize() const {
+        return PageSize;
+    }
+
+    TextureAtlas::Page& TextureAtlas::CreatePage(int _size) {
+
+        Page page;
+        page.size = _size;
+        page.texture = std::make_shared<Texture>(glm::vec2(_size, _size));
+
+        // Texture storage starts out undefined
+        glad_glClearTexImage(page.texture->GetTextureID(), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        page.skyline.push_back({ 0, 0, _size });
+
+        pages.push_back(page);
+
+        return pages.back();
+    }
+
+    // Checks whether a _width x _height rect fits with its left edge on skyline node _index, and at what height
+    bool TextureAtlas::Fit(const Page& _page, size_t _index, int _width, int _height, int& _y) const {
+
+        int x = _page.skyline[_index].x;
+
+        if (x + _width > _page.size)
+            return false;
+
+        int remaining = _width;
+        _y = _page.skyline[_index].y;
+
+        for (size_t i = _index; remaining > 0; i++) {
+
+            if (i >= _page.skyline.size())
+                return false;
+
+            _y = std::max(_y, _page.skyline[i].y);
+
+            if (_y + _height > _page.size)
+                return false;
+
+            remaining -= _page.skyline[i].width;
+        }
+
+        return true;
+    }
+
+    bool TextureAtlas::Pack(Page& _page, int _width, int _height, glm::ivec2& _position) {
+
+        int BestY = INT_MAX;
+        int BestWidth = INT_MAX;
+        size_t BestIndex = _page.skyline.size();
+
+        // Bottom-left heuristic, ties go to the narrowest node
+        for (size_t i = 0; i < _page.skyline.size(); i++) {
+
+            int y = 0;
+
+            if (!Fit(_page, i, _width, _height, y))
+                continue;
+
+            if (y + _height < BestY || (y + _height == BestY && _page.skyline[i].width < BestWidth)) {
+                BestY = y + _height;
+                BestWidth = _page.skyline[i].width;
+                BestIndex = i;
+                _position = { _page.skyline[i].x, y };
+            }
+        }
+
+        if (BestIndex == _page.skyline.size())
+            return false;
+
+        // Raise the skyline over the packed rect
+        _page.skyline.insert(_page.skyline.begin() + BestIndex, { _position.x, _position.y + _height, _width });
+
+        for (size_t i = BestIndex + 1; i < _page.skyline.size(); ) {
+
+            SkylineNode& previous = _page.skyline[i - 1];
+            SkylineNode& node = _page.skyline[i];
+
+            if (node.x >= previous.x + previous.width)
+                break;
+
+            int shrink = previous.x + previous.width - node.x;
+
+            node.x += shrink;
+            node.width -= shrink;
+
+            if (node.width > 0)
+                break;
+
+            _page.skyline.erase(_page.skyline.begin() + i);
+        }
+
+        // Merge neighbours at the same height
+        for (size_t i = 0; i + 1 < _page.skyline.size(); ) {
+
+            if (_page.skyline[i].y == _page.skyline[i + 1].y) {
+                _page.skyline[i].width += _page.skyline[i + 1].width;
+                _page.skyline.erase(_page.skyline.begin() + i + 1);
+            }
+            else
+                i++;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,101 @@
+// Fleet : engine/graphics/atlas.hpp (c) 2021 Andrew Woo
+
+/* Modified MIT License
+ *
+ * Copyright 2021 Andrew Woo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * Restrictions:
+ >  The Software may not be sold unless significant, mechanics changing modifications are made by the seller, or unless the buyer
+ >  understands an unmodified version of the Software is available elsewhere free of charge, and agrees to buy the Software given
+ >  this knowledge.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#ifndef FLEET_ENGINE_GRAPHICS_ATLAS
+#define FLEET_ENGINE_GRAPHICS_ATLAS
+
+// Include standard library
+#include <map>
+#include <array>
+#include <string>
+#include <vector>
+#include <memory>
+
+// Include dependencies
+#include <GLM/glm/glm.hpp>
+
+// Include Fleet libraries
+#include "texture.hpp"
+
+namespace Fleet::Core::Graphics {
+
+    struct AtlasRegion {
+
+        std::shared_ptr<Texture> page;              // Atlas page the region was packed into
+        glm::vec2 dimensions;                       // Region size in pixels
+
+        std::array<glm::vec2, 4> TexCoords;         // Bottom left to top left counter clockwise
+        glm::vec4 TexRect;                          // { u0, v0, u1, v1 }
+    };
+
+    class TextureAtlas {
+
+        /// Packs textures into large atlas pages (skyline bottom-left packer)
+
+    public:
+
+        TextureAtlas(int _PageSize = 2048, int _padding = 2);
+
+        // Load a PNG (or any image stb can read) and pack it. Regions are cached by path.
+        const std::shared_ptr<AtlasRegion>& Add(const std::string& _path);
+
+        // Pack raw RGBA8 pixel data under _name
+        const std::shared_ptr<AtlasRegion>& Add(const std::string& _name, const void* _data, int _width, int _height);
+
+        const std::shared_ptr<AtlasRegion>& Get(const std::string& _name);
+
+        const size_t GetPageCount() const;
+        const int GetPageSize() const;
+
+    private:
+
+        struct SkylineNode {
+            int x;
+            int y;
+            int width;
+        };
+
+        struct Page {
+            int size;
+            std::shared_ptr<Texture> texture;
+            std::vector<SkylineNode> skyline;
+        };
+
+        Page& CreatePage(int _size);
+
+        bool Fit(const Page& _page, size_t _index, int _width, int _height, int& _y) const;
+        bool Pack(Page& _page, int _width, int _height, glm::ivec2& _position);
+
+        int PageSize;
+        int padding;
+
+        std::vector<Page> pages;
+        std::map<std::string, std::shared_ptr<AtlasRegion>> regions;
+
+        std::shared_ptr<AtlasRegion> empty;
+    };
+}
+
+#endif // !FLEET_ENGINE_GRAPHICS_ATLAS
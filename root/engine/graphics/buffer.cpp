@@ -26,14 +26,17 @@
 #include <glad/glad.h>
 #include <ASWL/logger.hpp>
 
+#include "manager.hpp"
+
 namespace Fleet::Core::Graphics {
 
-    BufferElement::BufferElement(ShaderDataType _type, const std::string& _name, bool _normalized) {
+    BufferElement::BufferElement(ShaderDataType _type, const std::string& _name, bool _normalized, unsigned int _divisor) {
         
         type = _type;
         name = _name;
         size = ShaderDataTypeSize(_type);
         normalized = _normalized;
+        divisor = _divisor;
     }
 
     uint32_t BufferElement::GetComponentCount() const {
@@ -108,23 +111,36 @@ namespace Fleet::Core::Graphics {
     // ***********************************************************
     VertexBuffer::VertexBuffer() {
         vtxbobj = 0;
+        mapped = nullptr;
+        RegionSize = 0;
+        region = 0;
     }
 
     VertexBuffer::~VertexBuffer() {
+
+        for (auto& fence : fences) {
+            if (fence)
+                glad_glDeleteSync(fence);
+        }
+
+        if (mapped)
+            glad_glUnmapNamedBuffer(vtxbobj);
+
+        Manager::ForgetBuffer(vtxbobj);
         glad_glDeleteBuffers(1, &vtxbobj);
     }
 
     void VertexBuffer::Bind() const {
-        glad_glBindBuffer(GL_ARRAY_BUFFER, vtxbobj);
+        Manager::BindBuffer(GL_ARRAY_BUFFER, vtxbobj);
     }
 
     void VertexBuffer::Unbind() const {
-        glad_glBindBuffer(GL_ARRAY_BUFFER, 0);
+        Manager::BindBuffer(GL_ARRAY_BUFFER, 0);
     }
 
+    // Buffers are written by name, nothing has to be bound
     void VertexBuffer::SetData(const void* _data, const uint32_t _size) {
-        glad_glBindBuffer(GL_ARRAY_BUFFER, vtxbobj);
-        glad_glBufferSubData(GL_ARRAY_BUFFER, 0, _size, _data);
+        glad_glNamedBufferSubData(vtxbobj, 0, _size, _data);
     }
 
     const BufferLayout& VertexBuffer::GetLayout() const {
@@ -136,13 +152,84 @@ namespace Fleet::Core::Graphics {
 
     void VertexBuffer::Create(uint32_t _size) {
         glad_glCreateBuffers(1, &vtxbobj);
-        glad_glBindBuffer(GL_ARRAY_BUFFER, vtxbobj);
-        glad_glBufferData(GL_ARRAY_BUFFER, _size, nullptr, GL_DYNAMIC_DRAW);
+        glad_glNamedBufferData(vtxbobj, _size, nullptr, GL_DYNAMIC_DRAW);
     }
     void VertexBuffer::Create(float* _vertices, uint32_t _size) {
         glad_glCreateBuffers(1, &vtxbobj);
-        glad_glBindBuffer(GL_ARRAY_BUFFER, vtxbobj);
-        glad_glBufferData(GL_ARRAY_BUFFER, _size, _vertices, GL_STATIC_DRAW);
+        glad_glNamedBufferData(vtxbobj, _size, _vertices, GL_STATIC_DRAW);
+    }
+
+    void VertexBuffer::CreateStatic(const void* _data, uint32_t _size) {
+        glad_glCreateBuffers(1, &vtxbobj);
+        glad_glNamedBufferStorage(vtxbobj, _size, _data, 0);
+    }
+
+    void VertexBuffer::CreatePersistent(uint32_t _RegionSize, uint32_t _regions) {
+
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        RegionSize = _RegionSize;
+        region = 0;
+        fences.assign(_regions, nullptr);
+
+        glad_glCreateBuffers(1, &vtxbobj);
+        glad_glNamedBufferStorage(vtxbobj, static_cast<GLsizeiptr>(RegionSize) * _regions, nullptr, flags);
+
+        mapped = glad_glMapNamedBufferRange(vtxbobj, 0, static_cast<GLsizeiptr>(RegionSize) * _regions, flags);
+
+        if (!mapped)
+            ASWL::Logger::logger("VB001", "Error: Failed to map persistent vertex buffer.");
+    }
+
+    void* VertexBuffer::MapRegion() {
+
+        GLsync& fence = fences[region];
+
+        // Wait for the GPU to finish reading this region. Only the first wait flushes the command queue.
+        if (fence) {
+
+            GLbitfield WaitFlags = 0;
+            GLuint64 timeout = 0;
+
+            while (true) {
+
+                GLenum result = glad_glClientWaitSync(fence, WaitFlags, timeout);
+
+                if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+                    break;
+                if (result == GL_WAIT_FAILED) {
+                    ASWL::Logger::logger("VB002", "Error: Failed to wait on vertex buffer fence.");
+                    break;
+                }
+
+                WaitFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+                timeout = 1000000;  // 1ms
+            }
+
+            glad_glDeleteSync(fence);
+            fence = nullptr;
+        }
+
+        return static_cast<uint8_t*>(mapped) + static_cast<size_t>(region) * RegionSize;
+    }
+
+    void VertexBuffer::FenceRegion() {
+
+        if (fences[region])
+            glad_glDeleteSync(fences[region]);
+
+        fences[region] = glad_glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        region = (region + 1) % static_cast<uint32_t>(fences.size());
+    }
+
+    const bool VertexBuffer::IsPersistent() const {
+        return mapped != nullptr;
+    }
+    const uint32_t VertexBuffer::GetRegion() const {
+        return region;
+    }
+    const uint32_t VertexBuffer::GetRegionSize() const {
+        return RegionSize;
     }
 
     // ***********************************************************
@@ -153,18 +240,18 @@ namespace Fleet::Core::Graphics {
         count = sizeof(indices) / sizeof(uint32_t);
 
         glad_glCreateBuffers(1, &idxbobj);
-        glad_glBindBuffer(GL_ARRAY_BUFFER, idxbobj);
-        glad_glBufferData(GL_ARRAY_BUFFER, _size , indices, GL_STATIC_DRAW);
+        glad_glNamedBufferData(idxbobj, _size, indices, GL_STATIC_DRAW);
     }
     IndexBuffer::~IndexBuffer() {
+        Manager::ForgetBuffer(idxbobj);
         glad_glDeleteBuffers(1, &idxbobj);
     }
 
     void IndexBuffer::Bind() const {
-        glad_glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, idxbobj);
+        Manager::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, idxbobj);
     }
     void IndexBuffer::Unbind() const {
-        glad_glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        Manager::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     }
 
     const unsigned int IndexBuffer::GetCount() const {
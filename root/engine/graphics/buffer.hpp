@@ -45,9 +45,10 @@ namespace Fleet::Core::Graphics {
         unsigned int size;
         size_t offset;
         bool normalized;
+        unsigned int divisor;       // 0 -> per vertex, 1 -> per instance
 
         BufferElement() = default;
-        BufferElement(ShaderDataType _type, const std::string& _name, bool _normalized = false);
+        BufferElement(ShaderDataType _type, const std::string& _name, bool _normalized = false, unsigned int _divisor = 0);
 
         uint32_t GetComponentCount() const;
     };
@@ -100,11 +101,29 @@ namespace Fleet::Core::Graphics {
 
         void Create(uint32_t _size);
         void Create(float* _vertices, uint32_t _size);
+        void CreateStatic(const void* _data, uint32_t _size);       // Immutable storage, recreate the buffer to change it
+
+        // Persistent mapped streaming. The buffer is split into _regions equally sized regions, each guarded
+        // by a fence, so the CPU writes directly into GPU visible memory while the GPU reads the previous ones.
+        void CreatePersistent(uint32_t _RegionSize, uint32_t _regions = 3);
+
+        void* MapRegion();          // Waits until the current region is released by the GPU, then returns it
+        void FenceRegion();         // Fences the current region after it has been drawn, then advances the ring
+
+        const bool IsPersistent() const;
+        const uint32_t GetRegion() const;
+        const uint32_t GetRegionSize() const;
 
     private:
 
         unsigned int vtxbobj;
         BufferLayout layout;
+
+        // Persistent mapping data
+        void* mapped;
+        uint32_t RegionSize;
+        uint32_t region;
+        std::vector<GLsync> fences;
     };
 
     class IndexBuffer {
@@ -25,8 +25,11 @@
 
 // Include standard library
 #include <map>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
-//#include <algorithm>
+#include <algorithm>
+#include <type_traits>
 
 // Include dependencies
 #include <glad/glad.h>
@@ -34,137 +37,712 @@
 
 namespace Fleet::Core::Graphics {
 
+    // Atlas cache file: header, glyph table, Latin-1 index, extended index, atlas pixels
+    struct AtlasCacheHeader {
+
+        char magic[4];
+        uint32_t version;
+
+        int32_t AtlasSize;
+        int32_t PenX;
+        int32_t PenY;
+        int32_t ShelfHeight;
+        uint32_t full;
+
+        uint32_t GlyphCount;
+        uint32_t ExtendedCount;
+    };
+
+    struct AtlasCacheEntry {
+        uint32_t codepoint;
+        uint32_t index;
+    };
+
+    static constexpr char AtlasCacheMagic[4] = { 'F', 'F', 'N', 'T' };
+    static constexpr uint32_t AtlasCacheVersion = 1;
+
+    static_assert(std::is_trivially_copyable_v<Character>, "Glyphs are written to the atlas cache as is");
+
+    // SDF needs FreeType 2.11, against older versions SDF fonts are built as bitmap fonts
+    static FontMode SupportedMode(FontMode _mode, const std::string& _FontName) {
+
+        if (_mode == FontMode::SDF && !FLEET_FREETYPE_SDF) {
+            ASWL::Logger::logger("F0004", "Error: SDF fonts need FreeType 2.11 or newer, [", _FontName, "] falls back to bitmap glyphs.");
+            return FontMode::BITMAP;
+        }
+
+        return _mode;
+    }
+
+    uint32_t DecodeUTF8(const std::string& _string, size_t& _index) {
+
+        const uint32_t replacement = 0xFFFD;
+
+        unsigned char lead = static_cast<unsigned char>(_string[_index++]);
+
+        if (lead < 0x80)
+            return lead;
+
+        int length = 0;
+        uint32_t codepoint = 0;
+
+        if ((lead & 0xE0) == 0xC0) {
+            length = 1;
+            codepoint = lead & 0x1F;
+        }
+        else if ((lead & 0xF0) == 0xE0) {
+            length = 2;
+            codepoint = lead & 0x0F;
+        }
+        else if ((lead & 0xF8) == 0xF0) {
+            length = 3;
+            codepoint = lead & 0x07;
+        }
+        else
+            return replacement;
+
+        for (int i = 0; i < length; i++) {
+
+            if (_index >= _string.size() || (static_cast<unsigned char>(_string[_index]) & 0xC0) != 0x80)
+                return replacement;
+
+            codepoint = (codepoint << 6) | (static_cast<unsigned char>(_string[_index++]) & 0x3F);
+        }
+
+        // Overlong encodings and UTF-16 surrogates are malformed too
+        static constexpr uint32_t minimum[4] = { 0, 0x80, 0x800, 0x10000 };
+
+        if (codepoint < minimum[length] || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+            return replacement;
+
+        return codepoint;
+    }
+
+    // Font Face
+    FontFace::FontFace(const std::string& _FontPath) {
+
+        path = _FontPath;
+
+        if (!file.open(path)) {
+            ASWL::Logger::logger("F0001", "Error: Failed to load font face [", path, "].");
+            return;
+        }
+
+        hash = Cache::Hash(file.GetData(), file.GetSize());
+    }
+    FontFace::~FontFace() {
+
+        // Also releases the sizes fonts didn't release themselves
+        if (face)
+            FT_Done_Face(face);
+        if (library)
+            FT_Done_FreeType(library);
+    }
+
+    bool FontFace::Open() {
+
+        if (face)
+            return true;
+
+        // Only report a broken file once
+        if (failed || !file.IsOpen())
+            return false;
+
+        failed = true;
+
+        if (FT_Init_FreeType(&library)) {
+            ASWL::Logger::logger("F0000", "Error: Failed to initialize FreeType2.");
+            library = nullptr;
+            return false;
+        }
+
+        // FreeType reads the face straight out of the mapping
+        if (FT_New_Memory_Face(library, file.GetData(), static_cast<FT_Long>(file.GetSize()), 0, &face)) {
+            ASWL::Logger::logger("F0001", "Error: Failed to load font face [", path, "].");
+            face = nullptr;
+            return false;
+        }
+
+        failed = false;
+
+        return true;
+    }
+
+    // Font
     Font::Font() {
         FontName = "null";
         FontPath = "null";
         FontSize = 48;
         dimensions = { 0, 0 };
+        TextureID = 0;
+
+        glyphs.reserve(MaxGlyphs);
+        glyphs.push_back({ '?', { 0, 0 }, { 0, 0 }, { FontSize * 32, 0 }, {} });
     }
-    Font::Font(const std::string& _FontName, const std::string& _FontPath, int _FontSize) {
-        init(_FontName, _FontPath, _FontSize);
+    Font::Font(const std::string& _FontName, const std::string& _FontPath, int _FontSize, FontMode _mode) {
+        init(_FontName, _FontPath, _FontSize, _mode);
+    }
+    Font::Font(const std::shared_ptr<FontFace>& _face, const std::string& _FontName, int _FontSize, FontMode _mode) {
+        init(_face, _FontName, _FontSize, _mode);
+    }
+    Font::Font(const std::shared_ptr<Font>& _base, int _FontSize) {
+
+        base = _base;
+
+        FontName = base->FontName;
+        FontPath = base->FontPath;
+        FontSize = _FontSize;
+        mode = base->mode;
+
+        // Same texture as the base, so both share a scene texture slot
+        TextureID = base->TextureID;
+        dimensions = base->dimensions;
+        InternalFormat = base->InternalFormat;
+        DataFormat = base->DataFormat;
+
+        AtlasSize = base->AtlasSize;
     }
     Font::~Font() {
 
+        // The atlas belongs to the base font
+        if (base)
+            TextureID = 0;
+        else if (GlyphBuffer != 0)
+            glad_glDeleteBuffers(1, &GlyphBuffer);
+
+        if (size) {
+            std::lock_guard<std::mutex> lock(face->mutex);
+            FT_Done_Size(size);
+        }
     };
 
-    int Font::init(const std::string& _FontName, const std::string& _FontPath, int _FontSize) {
+    int Font::init(const std::string& _FontName, const std::string& _FontPath, int _FontSize, FontMode _mode) {
+        return init(std::make_shared<FontFace>(_FontPath), _FontName, _FontSize, _mode);
+    }
+    int Font::init(const std::shared_ptr<FontFace>& _face, const std::string& _FontName, int _FontSize, FontMode _mode) {
+
+        face = _face;
 
         FontName = _FontName;
-        FontPath = _FontPath;
+        FontPath = face->path;
         FontSize = _FontSize;
-        dimensions = { 0, 0 };
-        
-        FT_Library library;
-        if (FT_Init_FreeType(&library)) {
-            ASWL::Logger::logger("F0000", "Error: Failed to initialize FreeType2.");
-            return 1;
-        }
+        mode = SupportedMode(_mode, _FontName);
+
+        // Roughly 150 glyphs fit at any size, capped so atlas memory stays bounded
+        AtlasSize = 256;
+        while (AtlasSize < FontSize * 12 && AtlasSize < 2048)
+            AtlasSize *= 2;
+
+        dimensions = glm::vec2(AtlasSize, AtlasSize);
+
+        InternalFormat = GL_R8;
+        DataFormat = GL_RED;
+
+        pixels.assign(static_cast<size_t>(AtlasSize) * AtlasSize, 0);
+        pen = { 1, 1 };
+        ShelfHeight = 0;
+        full = false;
+
+        // Generate texture, cleared by the first Sync
+        glad_glCreateTextures(GL_TEXTURE_2D, 1, &TextureID);
+        glad_glTextureStorage2D(TextureID, 1, InternalFormat, AtlasSize, AtlasSize);
 
-        FT_Face face;
-        if (FT_New_Face(library, _FontPath.c_str(), 0, &face)) {
-            ASWL::Logger::logger("F0001", "Error: Failed to load font face [", _FontPath, "].");
+        // Set texture options
+        glad_glTextureParameteri(TextureID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glad_glTextureParameteri(TextureID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        glad_glTextureParameteri(TextureID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glad_glTextureParameteri(TextureID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        dirty = { 0, 0, AtlasSize, AtlasSize };
+
+        // Empty fallback glyph, replaced by '?' once the face is loaded
+        glyphs.clear();
+        glyphs.reserve(MaxGlyphs);
+        glyphs.push_back({ '?', { 0, 0 }, { 0, 0 }, { FontSize * 32, 0 }, {} });
+
+        for (auto& index : latin)
+            index.store(0);
+        extended.clear();
+
+        cached = false;
+        CacheFile.clear();
+
+        if (face->hash == 0)
             return 2;
+
+        // Same file, size, mode and prewarm range -> same atlas
+        uint64_t key = face->hash;
+        uint32_t parameters[] = { static_cast<uint32_t>(FontSize), static_cast<uint32_t>(mode), PrewarmFirst, PrewarmLast, AtlasCacheVersion };
+        key = Cache::Hash(parameters, sizeof(parameters), key);
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "-%d-%016llx.atlas", FontSize, static_cast<unsigned long long>(key));
+        CacheFile = Cache::Path("fonts", FontName + name);
+
+        // A warm start never touches FreeType
+        if (LoadCache())
+            return 0;
+
+        // Everything else is rasterized on first use
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            Rasterize('?', glyphs[0]);
+            latin['?'].store(1);
         }
 
-        // Set Font size
-        FT_Set_Pixel_Sizes(face, 0, FontSize);
+        Sync();
 
-        // Disable byte-alignment restriction
-        glad_glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        return 0;
+    }
 
-        for (unsigned char c = 32; c < 128; c++) {
+    const Character& Font::GetCharacter(uint32_t _codepoint) {
 
-            // Load glyph 
-            if (FT_Load_Char(face, c, FT_LOAD_RENDER)) {
-                ASWL::Logger::logger("F0002", "Error: Failed to load glyph [", std::to_string(c), "].");
-                continue;
-            }
+        if (base)
+            return base->GetCharacter(_codepoint);
+
+        if (_codepoint < latin.size()) {
 
-            // Calculate atlas dimensions
-            dimensions.x += face->glyph->bitmap.width + 1;
-            dimensions.y = std::max(dimensions.y, static_cast<float>(face->glyph->bitmap.rows));
+            uint16_t index = latin[_codepoint].load(std::memory_order_acquire);
+
+            if (index != 0)
+                return glyphs[index - 1];
         }
 
-        // Generate texture
-        glad_glGenTextures(1, &TextureID);
-        glad_glBindTexture(GL_TEXTURE_2D, TextureID);
-        glad_glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, dimensions.x, dimensions.y, 0, GL_RED, GL_UNSIGNED_BYTE, 0);
+        std::lock_guard<std::mutex> lock(mutex);
 
-        // Set texture options
-        glad_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glad_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        return glyphs[Insert(_codepoint)];
+    }
+
+    const uint16_t Font::GetGlyphIndex(uint32_t _codepoint) {
 
-        glad_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glad_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        if (base)
+            return base->GetGlyphIndex(_codepoint);
 
-        glad_glBindTexture(GL_TEXTURE_2D, TextureID);
+        // The table is dense, so the reference gives the index
+        return static_cast<uint16_t>(&GetCharacter(_codepoint) - glyphs.data());
+    }
 
-        int x = 0;
-        for (unsigned char c = 32; c < 128; c++) {
+    uint16_t Font::Insert(uint32_t _codepoint) {
 
-            // Load glyph 
-            if (FT_Load_Char(face, c, FT_LOAD_RENDER))      // No need to log error here, if error occurs, it will 
-                continue;                                   // already have been logged by the previous loop.
+        // Another thread may have added it while we waited for the lock
+        if (_codepoint < latin.size()) {
 
-            // Sub in glyph data
-            glad_glTexSubImage2D(GL_TEXTURE_2D, 0, x, 0, face->glyph->bitmap.width, face->glyph->bitmap.rows, GL_RED, GL_UNSIGNED_BYTE, face->glyph->bitmap.buffer);
+            uint16_t index = latin[_codepoint].load(std::memory_order_relaxed);
 
-            characters[c] = {
-                c,
-                { face->glyph->bitmap.width, face->glyph->bitmap.rows },
-                { face->glyph->bitmap_left, face->glyph->bitmap_top },
-                { face->glyph->advance.x, face->glyph->advance.y },
-                static_cast<float>(x) / dimensions.x,
-            };
+            if (index != 0)
+                return index - 1;
+        }
+        else {
 
-            // Bottom left to top left counter clockwise
-            characters[c].TexCoords = { { characters[c].tc_offset, 0 },                                                                             // Bottom Left
-                                        { characters[c].tc_offset + (characters[c].size.x / dimensions.x), 0 },                                     // Bottom Right
-                                        { characters[c].tc_offset + (characters[c].size.x / dimensions.x), characters[c].size.y / dimensions.y },   // Top Right
-                                        { characters[c].tc_offset, characters[c].size.y / dimensions.y } };                                         // Top Left
+            auto found = extended.find(_codepoint);
 
-            x += face->glyph->bitmap.width + 1;
+            if (found != extended.end())
+                return found->second;
         }
 
-        FT_Done_Face(face);
-        FT_Done_FreeType(library);
+        // Misses are remembered as the fallback, so the face isn't asked again
+        uint16_t index = 0;
+        Character ch;
 
-        return 0;
+        if (glyphs.size() < MaxGlyphs && Rasterize(_codepoint, ch)) {
+            glyphs.push_back(ch);
+            index = static_cast<uint16_t>(glyphs.size() - 1);
+        }
+
+        // The glyph is fully written before readers can see its index
+        if (_codepoint < latin.size())
+            latin[_codepoint].store(index + 1, std::memory_order_release);
+        else
+            extended.insert({ _codepoint, index });
+
+        return index;
     }
 
-    // Getters
-    const std::map<char, Character>& Font::GetCharacters() const {
-        return characters;
+    bool Font::Rasterize(uint32_t _codepoint, Character& _character) {
+
+        if (!face || full)
+            return false;
+
+        // Font mutex first, face mutex last, so fonts sharing a face never wait on each other in reverse
+        std::lock_guard<std::mutex> lock(face->mutex);
+
+        if (!Activate())
+            return false;
+
+        FT_Face ft = face->face;
+
+        if (FT_Get_Char_Index(ft, _codepoint) == 0)
+            return false;
+
+        // FT_RENDER_MODE_SDF needs FreeType 2.11, the distance spread is part of the bitmap and the bearings
+#if FLEET_FREETYPE_SDF
+        FT_Render_Mode RenderMode = (mode == FontMode::SDF) ? FT_RENDER_MODE_SDF : FT_RENDER_MODE_NORMAL;
+#else
+        FT_Render_Mode RenderMode = FT_RENDER_MODE_NORMAL;
+#endif
+
+        if (FT_Load_Char(ft, _codepoint, FT_LOAD_DEFAULT) || FT_Render_Glyph(ft->glyph, RenderMode)) {
+            ASWL::Logger::logger("F0002", "Error: Failed to load glyph [", std::to_string(_codepoint), "].");
+            return false;
+        }
+
+        const FT_Bitmap& bitmap = ft->glyph->bitmap;
+
+        int width = static_cast<int>(bitmap.width);
+        int height = static_cast<int>(bitmap.rows);
+
+        // Next shelf, glyphs keep a 1px gap so linear filtering doesn't bleed
+        if (pen.x + width + 1 > AtlasSize) {
+            pen = { 1, pen.y + ShelfHeight + 1 };
+            ShelfHeight = 0;
+        }
+
+        if (pen.y + height + 1 > AtlasSize) {
+            ASWL::Logger::logger("F0003", "Error: Glyph atlas is full [", FontName, " ", std::to_string(FontSize), "].");
+            full = true;
+            return false;
+        }
+
+        for (int row = 0; row < height; row++) {
+
+            const unsigned char* src = bitmap.buffer + static_cast<ptrdiff_t>(row) * bitmap.pitch;
+            std::copy(src, src + width, pixels.begin() + static_cast<size_t>(pen.y + row) * AtlasSize + pen.x);
+        }
+
+        if (dirty.x >= dirty.z)
+            dirty = { pen.x, pen.y, pen.x + width, pen.y + height };
+        else
+            dirty = { std::min(dirty.x, pen.x), std::min(dirty.y, pen.y), std::max(dirty.z, pen.x + width), std::max(dirty.w, pen.y + height) };
+
+        float u0 = static_cast<float>(pen.x) / AtlasSize;
+        float v0 = static_cast<float>(pen.y) / AtlasSize;
+        float u1 = static_cast<float>(pen.x + width) / AtlasSize;
+        float v1 = static_cast<float>(pen.y + height) / AtlasSize;
+
+        _character = {
+            _codepoint,
+            { width, height },
+            { ft->glyph->bitmap_left, ft->glyph->bitmap_top },
+            { ft->glyph->advance.x, ft->glyph->advance.y },
+
+            // Bottom left to top left counter clockwise (rows are stored top down, RenderText flips y on the CPU)
+            { glm::vec2(u0, v0), glm::vec2(u1, v0), glm::vec2(u1, v1), glm::vec2(u0, v1) }
+        };
+
+        pen.x += width + 1;
+        ShelfHeight = std::max(ShelfHeight, height);
+
+        return true;
     }
-    const int Font::GetSize() const {
-        return FontSize;
+
+    bool Font::Activate() {
+
+        if (!face->Open())
+            return false;
+
+        // Every font gets its own size object on the shared face
+        if (!size) {
+
+            if (FT_New_Size(face->face, &size)) {
+                size = nullptr;
+                return false;
+            }
+
+            FT_Activate_Size(size);
+            FT_Set_Pixel_Sizes(face->face, 0, FontSize);
+
+            return true;
+        }
+
+        FT_Activate_Size(size);
+
+        return true;
+    }
+
+    bool Font::LoadCache() {
+
+        Cache::MappedFile file(CacheFile);
+
+        if (!file.IsOpen())
+            return false;
+
+        const unsigned char* read = file.GetData();
+
+        AtlasCacheHeader header;
+
+        if (file.GetSize() < sizeof(header))
+            return false;
+
+        std::memcpy(&header, read, sizeof(header));
+        read += sizeof(header);
+
+        size_t expected = sizeof(header) + header.GlyphCount * sizeof(Character) + latin.size() * sizeof(uint16_t)
+                        + header.ExtendedCount * sizeof(AtlasCacheEntry) + static_cast<size_t>(AtlasSize) * AtlasSize;
+
+        if (std::memcmp(header.magic, AtlasCacheMagic, sizeof(AtlasCacheMagic)) != 0 || header.version != AtlasCacheVersion ||
+            header.AtlasSize != AtlasSize || header.GlyphCount == 0 || header.GlyphCount > MaxGlyphs || file.GetSize() != expected)
+            return false;
+
+        std::vector<Character> table(header.GlyphCount);
+        std::memcpy(table.data(), read, table.size() * sizeof(Character));
+        read += table.size() * sizeof(Character);
+
+        std::array<uint16_t, 256> indices;
+        std::memcpy(indices.data(), read, indices.size() * sizeof(uint16_t));
+        read += indices.size() * sizeof(uint16_t);
+
+        std::vector<AtlasCacheEntry> entries(header.ExtendedCount);
+        std::memcpy(entries.data(), read, entries.size() * sizeof(AtlasCacheEntry));
+        read += entries.size() * sizeof(AtlasCacheEntry);
+
+        // Don't trust indices from disk
+        for (uint16_t index : indices)
+            if (index > header.GlyphCount)
+                return false;
+        for (const AtlasCacheEntry& entry : entries)
+            if (entry.index >= header.GlyphCount)
+                return false;
+
+        glyphs.assign(table.begin(), table.end());
+
+        for (size_t i = 0; i < latin.size(); i++)
+            latin[i].store(indices[i], std::memory_order_relaxed);
+        for (const AtlasCacheEntry& entry : entries)
+            extended.insert({ entry.codepoint, static_cast<uint16_t>(entry.index) });
+
+        pen = { header.PenX, header.PenY };
+        ShelfHeight = header.ShelfHeight;
+        full = header.full != 0;
+
+        // Upload straight from the mapping, the CPU copy is only needed for glyphs added later
+        std::memcpy(pixels.data(), read, pixels.size());
+
+        glad_glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glad_glTextureSubImage2D(TextureID, 0, 0, 0, AtlasSize, AtlasSize, DataFormat, GL_UNSIGNED_BYTE, read);
+
+        dirty = { 0, 0, 0, 0 };
+        cached = true;
+
+        return true;
+    }
+
+    void Font::SaveCache() {
+
+        if (base || cached || CacheFile.empty())
+            return;
+
+        std::vector<unsigned char> data;
+
+        auto write = [&data](const void* _source, size_t _bytes) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(_source);
+            data.insert(data.end(), bytes, bytes + _bytes);
+        };
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            // Nothing was rasterized, the face is missing
+            if (!size)
+                return;
+
+            AtlasCacheHeader header = {};
+
+            std::memcpy(header.magic, AtlasCacheMagic, sizeof(AtlasCacheMagic));
+            header.version = AtlasCacheVersion;
+            header.AtlasSize = AtlasSize;
+            header.PenX = pen.x;
+            header.PenY = pen.y;
+            header.ShelfHeight = ShelfHeight;
+            header.full = full ? 1 : 0;
+            header.GlyphCount = static_cast<uint32_t>(glyphs.size());
+            header.ExtendedCount = static_cast<uint32_t>(extended.size());
+
+            data.reserve(sizeof(header) + glyphs.size() * sizeof(Character) + pixels.size() + 1024);
+
+            write(&header, sizeof(header));
+            write(glyphs.data(), glyphs.size() * sizeof(Character));
+
+            for (const auto& index : latin) {
+                uint16_t value = index.load(std::memory_order_relaxed);
+                write(&value, sizeof(value));
+            }
+
+            for (const auto& [codepoint, index] : extended) {
+                AtlasCacheEntry entry = { codepoint, index };
+                write(&entry, sizeof(entry));
+            }
+
+            write(pixels.data(), pixels.size());
+        }
+
+        Cache::Write(CacheFile, data);
+    }
+
+    void Font::Prewarm(uint32_t _first, uint32_t _last) {
+
+        if (base)
+            return;
+
+        // One glyph per lock, so the GL thread's Sync never waits on the whole range
+        for (uint32_t codepoint = _first; codepoint <= _last; codepoint++)
+            GetCharacter(codepoint);
+    }
+
+    void Font::Sync() {
+
+        if (base) {
+            base->Sync();
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (TextureID == 0)
+            return;
+
+        if (dirty.x < dirty.z) {
+
+            // Upload the dirty rectangle straight out of the CPU copy
+            glad_glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glad_glPixelStorei(GL_UNPACK_ROW_LENGTH, AtlasSize);
+
+            glad_glTextureSubImage2D(TextureID, 0, dirty.x, dirty.y, dirty.z - dirty.x, dirty.w - dirty.y, DataFormat, GL_UNSIGNED_BYTE,
+                                     pixels.data() + static_cast<size_t>(dirty.y) * AtlasSize + dirty.x);
+
+            glad_glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+            dirty = { 0, 0, 0, 0 };
+        }
+
+        // Glyphs are only ever appended, so only the new ones are uploaded
+        if (GlyphBuffer != 0 && GlyphsUploaded < glyphs.size()) {
+
+            std::vector<glm::vec4> metrics;
+            metrics.reserve((glyphs.size() - GlyphsUploaded) * 2);
+
+            for (size_t i = GlyphsUploaded; i < glyphs.size(); i++) {
+
+                const Character& ch = glyphs[i];
+
+                metrics.push_back({ ch.bearing.x, ch.bearing.y, ch.size.x, ch.size.y });
+                metrics.push_back({ ch.TexCoords[0].x, ch.TexCoords[0].y, ch.TexCoords[2].x, ch.TexCoords[2].y });
+            }
+
+            glad_glNamedBufferSubData(GlyphBuffer, GlyphsUploaded * 2 * sizeof(glm::vec4), metrics.size() * sizeof(glm::vec4), metrics.data());
+
+            GlyphsUploaded = glyphs.size();
+        }
     }
-    std::vector<glm::vec2> Font::GetTexCoords(char _character) {
 
-        std::vector<glm::vec2> texcoords = { { 0.f, 0.f }, { 1.f, 0.f }, { 1.f, 1.f }, { 0.f, 1.f } };
+    const unsigned int Font::GetGlyphBuffer() {
 
-        Character ch = characters[_character];
+        if (base)
+            return base->GetGlyphBuffer();
 
-        // Bottom left to top left counter clockwise
-        texcoords[0] = { ch.tc_offset, 0 };                                                         // Bottom Left
-        texcoords[1] = { ch.tc_offset + (ch.size.x / dimensions.x), 0 };                            // Bottom Right
-        texcoords[2] = { ch.tc_offset + (ch.size.x / dimensions.x), ch.size.y / dimensions.y };     // Top Right
-        texcoords[3] = { ch.tc_offset, ch.size.y / dimensions.y };                                  // Top Left
+        if (GlyphBuffer == 0) {
 
-        return texcoords;
+            glad_glCreateBuffers(1, &GlyphBuffer);
+            glad_glNamedBufferStorage(GlyphBuffer, MaxGlyphs * 2 * sizeof(glm::vec4), nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+            GlyphsUploaded = 0;
+        }
+
+        return GlyphBuffer;
+    }
+
+    // Getters
+    const int Font::GetSize() const {
+        return FontSize;
+    }
+    const float Font::GetScale() const {
+        return base ? static_cast<float>(FontSize) / base->FontSize : 1.f;
+    }
+    const FontMode Font::GetMode() const {
+        return mode;
+    }
+    const int Font::GetAtlasSize() const {
+        return AtlasSize;
+    }
+    const bool Font::IsCached() const {
+        return cached;
+    }
+    std::array<glm::vec2, 4> Font::GetTexCoords(uint32_t _codepoint) {
+        return GetCharacter(_codepoint).TexCoords;
     }
 
     // Font Library
-    FontLibrary::FontLibrary(const std::string& _FontName, const std::string& _FontPath) {
+    FontLibrary::FontLibrary(const std::string& _FontName, const std::string& _FontPath, FontMode _mode) {
         
         FontName = _FontName;
         FontPath = _FontPath;
+        mode = SupportedMode(_mode, _FontName);
+
+        face = std::make_shared<FontFace>(FontPath);
+        worker = std::thread(&FontLibrary::Worker, this);
+
+        AddSize(48);
 
-        fl.insert({ 48, std::make_shared<Font>(FontName, FontPath) });
+        if (mode == FontMode::SDF)
+            base = fl[48];
+    }
+    FontLibrary::~FontLibrary() {
+
+        {
+            std::lock_guard<std::mutex> lock(JobMutex);
+            stop = true;
+        }
+
+        JobReady.notify_one();
+        worker.join();
     }
 
     void FontLibrary::AddSize(int _size) {
-        fl.insert({ _size, std::make_shared<Font>(FontName, FontPath, _size) });
+
+        if (fl.count(_size) != 0)
+            return;
+
+        if (base) {
+            fl.insert({ _size, std::make_shared<Font>(base, _size) });
+            return;
+        }
+
+        // GL texture is created (or loaded from the disk cache) here, glyphs are rasterized by the worker and uploaded by the next Sync
+        std::shared_ptr<Font> font = std::make_shared<Font>(face, FontName, _size, mode);
+        fl.insert({ _size, font });
+
+        if (font->IsCached())
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(JobMutex);
+            jobs.push_back(font);
+        }
+
+        JobReady.notify_one();
+    }
+
+    void FontLibrary::Worker() {
+
+        while (true) {
+
+            std::shared_ptr<Font> font;
+
+            {
+                std::unique_lock<std::mutex> lock(JobMutex);
+                JobReady.wait(lock, [this] { return stop || !jobs.empty(); });
+
+                if (stop)
+                    return;
+
+                font = jobs.front();
+                jobs.pop_front();
+            }
+
+            font->Prewarm(Font::PrewarmFirst, Font::PrewarmLast);
+            font->SaveCache();
+        }
     }
 
     const std::shared_ptr<Font>& FontLibrary::GetFont(int _size) {
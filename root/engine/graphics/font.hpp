@@ -27,66 +27,170 @@
 #define FLEET_ENGINE_GRAPHICS_FONT
 
 // Include standard library
+#include <array>
 #include <string>
 #include <vector>
 #include <memory>
 #include <map>
+#include <mutex>
+#include <atomic>
+#include <deque>
+#include <thread>
+#include <condition_variable>
+#include <cstdint>
+#include <unordered_map>
 
 // Include dependencies
 #include <GLM/glm/glm.hpp>
 #include <FREETYPE/include/ft2build.h>
 #include FT_FREETYPE_H
+#include FT_SIZES_H
+
+// FT_RENDER_MODE_SDF arrived in FreeType 2.11, SDF fonts fall back to bitmap glyphs before it
+#if FREETYPE_MAJOR > 2 || (FREETYPE_MAJOR == 2 && FREETYPE_MINOR >= 11)
+    #define FLEET_FREETYPE_SDF 1
+#else
+    #define FLEET_FREETYPE_SDF 0
+#endif
 
 // Include Fleet libraries
 #include "texture.hpp"
+#include "../cache.hpp"
 
 namespace Fleet::Core::Graphics {
 
     struct Character {
 
-        unsigned char character;
+        uint32_t codepoint;
         glm::vec2 size;
         glm::vec2 bearing;
         glm::vec2 advance;
-        float tc_offset;
 
-        std::vector<glm::vec2> TexCoords;
+        std::array<glm::vec2, 4> TexCoords;
+    };
+
+    enum class FontMode {
+        BITMAP,         // Coverage glyphs rasterized per pixel size ("text" shader)
+        SDF             // Signed distance field glyphs, one atlas scaled to every size ("text_sdf" shader), FreeType 2.11+
+    };
+
+    struct FontFace {
+
+        /// One font file, mapped once and shared by every size loaded from it. FreeType is only started the
+        /// first time a glyph has to be rasterized. FreeType objects aren't thread safe, hold the mutex while using them.
+
+        FontFace(const std::string& _FontPath);
+        ~FontFace();
+
+        bool Open();        // Loads the face on first use, expects the mutex to be held
+
+        std::string path;
+        uint64_t hash = 0;          // Of the file contents, 0 if it couldn't be read
+
+        Cache::MappedFile file;
+
+        FT_Library library = nullptr;
+        FT_Face face = nullptr;
+        bool failed = false;
+
+        std::mutex mutex;
     };
 
+    // Decodes the UTF-8 sequence starting at _index and moves _index past it. Malformed input (truncated or overlong
+    // sequences, surrogates, past U+10FFFF) decodes to U+FFFD.
+    uint32_t DecodeUTF8(const std::string& _string, size_t& _index);
+
     class Font : public Texture {
 
-        /// Font objects & rendering
+        /// Font objects & rendering. Glyphs are rasterized on first use into a fixed size square atlas. The atlas
+        /// is saved to cache/fonts once the prewarm range is rasterized, and loaded from there on the next launch.
 
     public:
 
+        // Glyph range rasterized ahead of use, part of the disk cache key
+        static constexpr uint32_t PrewarmFirst = 32;
+        static constexpr uint32_t PrewarmLast = 126;
+
         Font();
-        Font(const std::string& _FontName, const std::string& _FontPath, int _FontSize = 48);
+        Font(const std::string& _FontName, const std::string& _FontPath, int _FontSize = 48, FontMode _mode = FontMode::BITMAP);
+        Font(const std::shared_ptr<FontFace>& _face, const std::string& _FontName, int _FontSize = 48, FontMode _mode = FontMode::BITMAP);
+        Font(const std::shared_ptr<Font>& _base, int _FontSize);        // View of _base at another size, shares its atlas
         ~Font();
 
-        int init(const std::string& _FontName, const std::string& _FontPath, int _FontSize = 48);
+        int init(const std::string& _FontName, const std::string& _FontPath, int _FontSize = 48, FontMode _mode = FontMode::BITMAP);
+        int init(const std::shared_ptr<FontFace>& _face, const std::string& _FontName, int _FontSize = 48, FontMode _mode = FontMode::BITMAP);
+
+        // Rasterizes missing glyphs, safe to call from any thread. Glyphs that don't exist or don't fit in the
+        // atlas anymore resolve to the fallback glyph ('?'). Latin-1 lookups don't take the lock once cached.
+        const Character& GetCharacter(uint32_t _codepoint);
+        const uint16_t GetGlyphIndex(uint32_t _codepoint);         // Index into the glyph table, 0 is the fallback glyph
+
+        void Prewarm(uint32_t _first, uint32_t _last);      // Rasterizes [_first, _last] ahead of use, meant for worker threads
+        void SaveCache();           // Writes the atlas & glyph table to the disk cache, safe to call from any thread
+        void Sync() override;       // Uploads newly rasterized glyphs and their metrics (GL thread)
+
+        // Glyph table as a GPU storage buffer of { bearing, size } { u0, v0, u1, v1 } pairs, created on first use
+        // (GL thread). Sync keeps it up to date.
+        const unsigned int GetGlyphBuffer();
 
         // Getters
-        const std::map<char, Character>& GetCharacters() const;
         const int GetSize() const;
-        std::vector<glm::vec2> GetTexCoords(char _character);
+        const float GetScale() const;       // Size relative to the rasterized glyphs, 1 unless this is a view
+        const FontMode GetMode() const;
+        const int GetAtlasSize() const;
+        const bool IsCached() const;        // Loaded from the disk cache
+        std::array<glm::vec2, 4> GetTexCoords(uint32_t _codepoint);
 
     private:
 
+        uint16_t Insert(uint32_t _codepoint);                           // Expects the glyph mutex to be held
+        bool Rasterize(uint32_t _codepoint, Character& _character);     // Expects the glyph mutex to be held
+        bool Activate();                                                // Expects the face mutex to be held
+        bool LoadCache();                                               // GL thread, before other threads see the font
+
         std::string FontName;
         std::string FontPath;
 
         int FontSize;
+        FontMode mode = FontMode::BITMAP;
+
+        std::shared_ptr<Font> base;         // Set for views
+
+        std::shared_ptr<FontFace> face;
+        FT_Size size = nullptr;             // This font's pixel size on the shared face, created on first rasterization
+
+        std::string CacheFile;
+        bool cached = false;
 
-        std::map<char, Character> characters;
+        // Glyph table. Dense, and reserved up front so references stay valid while other threads add glyphs.
+        static constexpr size_t MaxGlyphs = 4096;
+
+        std::mutex mutex;
+        std::vector<Character> glyphs;                          // Index 0 is the fallback glyph
+        std::array<std::atomic<uint16_t>, 256> latin {};        // Latin-1 codepoint -> glyph index + 1, 0 -> not cached
+        std::unordered_map<uint32_t, uint16_t> extended;        // Other codepoints -> glyph index
+
+        // Glyph atlas (shelf packed), CPU copy and the region not uploaded yet
+        int AtlasSize = 0;
+        std::vector<unsigned char> pixels;
+        glm::ivec2 pen = { 0, 0 };
+        int ShelfHeight = 0;
+        glm::ivec4 dirty = { 0, 0, 0, 0 };      // { x0, y0, x1, y1 }
+        bool full = false;
+
+        unsigned int GlyphBuffer = 0;
+        size_t GlyphsUploaded = 0;
     };
 
     class FontLibrary {
 
-        /// Font library manages a particular font
+        /// Font library manages a particular font. Every size shares one FreeType face, and a worker thread
+        /// rasterizes the printable ASCII range of new sizes while the GL thread only uploads the result.
 
     public:
 
-        FontLibrary(const std::string& _FontName, const std::string& _FontPath);
+        FontLibrary(const std::string& _FontName, const std::string& _FontPath, FontMode _mode = FontMode::BITMAP);
+        ~FontLibrary();
 
         void AddSize(int _size);    // Creates a bew font object of the desired size
         const std::shared_ptr<Font>& GetFont(int _size);
@@ -95,8 +199,21 @@ namespace Fleet::Core::Graphics {
 
         std::string FontName;
         std::string FontPath;
+        FontMode mode;
 
         std::map<int, std::shared_ptr<Font>> fl;
+        std::shared_ptr<Font> base;         // SDF mode rasterizes once, every size is a view of this font
+
+        std::shared_ptr<FontFace> face;
+
+        // Prewarm worker
+        void Worker();
+
+        std::thread worker;
+        std::mutex JobMutex;
+        std::condition_variable JobReady;
+        std::deque<std::shared_ptr<Font>> jobs;
+        bool stop = false;
     };
 }
 
@@ -22,10 +22,27 @@
 */
 
 #include "manager.hpp"
+#include "statistics.hpp"
+#include "profiler.hpp"
 #include <iostream>
+#include <vector>
 
 namespace Fleet::Core::Graphics::Manager {
 
+    // Bound objects as last sent to the driver, Unknown forces the next bind
+    static constexpr unsigned int Unknown = 0xFFFFFFFF;
+
+    struct StateCache {
+
+        unsigned int program = Unknown;
+        unsigned int ArrayBuffer = Unknown;
+        unsigned int ElementBuffer = Unknown;   // Part of the vertex array, unknown after every vertex array change
+        unsigned int VertexArray = Unknown;
+        std::vector<unsigned int> TextureUnits;
+    };
+
+    static StateCache sState;
+
     void init(const glm::vec4& color) {
 
         glad_glEnable(GL_BLEND);
@@ -39,7 +56,7 @@ namespace Fleet::Core::Graphics::Manager {
         SetClearColor(color);
     }
     void shutdown() {
-
+        Profiler::shutdown();
     }
 
     void SetViewPort(int x, int y, int width, int height) {
@@ -54,17 +71,122 @@ namespace Fleet::Core::Graphics::Manager {
     }
 
     void BeginRender() {
+        Statistics::BeginFrame();
+        Profiler::BeginFrame();
         Clear();
     }
     void EndRender(GLFWwindow* window) {
+        Profiler::EndFrame();
         glfwSwapBuffers(window);
     }
 
-    void DrawIndexed(const std::unique_ptr<VertexArray>& vtxArray, int _count) {
+    void DrawIndexed(const std::unique_ptr<VertexArray>& vtxArray, int _count, int _BaseVertex) {
 
         unsigned int count = (_count == -1) ? vtxArray->GetIndexBuffer()->GetCount() * 6 : _count;
 
-        glad_glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
+        glad_glDrawElementsBaseVertex(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr, _BaseVertex);
+        Statistics::CountDrawCall();
         //glad_glBindTexture(GL_TEXTURE_2D, 0);
     }
+    void DrawIndexedInstanced(const std::unique_ptr<VertexArray>& vtxArray, int _count, int _InstanceCount, int _BaseInstance) {
+        glad_glDrawElementsInstancedBaseInstance(GL_TRIANGLES, _count, GL_UNSIGNED_INT, nullptr, _InstanceCount, _BaseInstance);
+        Statistics::CountDrawCall();
+    }
+
+    // State cache
+    void UseProgram(unsigned int _program) {
+
+        if (sState.program == _program) {
+            Statistics::CountSkippedBind();
+            return;
+        }
+
+        glad_glUseProgram(_program);
+        sState.program = _program;
+
+        Statistics::CountShaderBind();
+    }
+    void BindBuffer(GLenum _target, unsigned int _buffer) {
+
+        unsigned int* bound = nullptr;
+
+        switch (_target) {
+
+        case GL_ARRAY_BUFFER:           bound = &sState.ArrayBuffer; break;
+        case GL_ELEMENT_ARRAY_BUFFER:   bound = &sState.ElementBuffer; break;
+
+        default:
+            glad_glBindBuffer(_target, _buffer);
+            return;
+        }
+
+        if (*bound == _buffer) {
+            Statistics::CountSkippedBind();
+            return;
+        }
+
+        glad_glBindBuffer(_target, _buffer);
+        *bound = _buffer;
+    }
+    void BindVertexArray(unsigned int _vtxArray) {
+
+        if (sState.VertexArray == _vtxArray) {
+            Statistics::CountSkippedBind();
+            return;
+        }
+
+        glad_glBindVertexArray(_vtxArray);
+        sState.VertexArray = _vtxArray;
+        sState.ElementBuffer = Unknown;
+    }
+    void BindTextureUnit(unsigned int _unit, unsigned int _texture) {
+
+        if (_unit >= sState.TextureUnits.size())
+            sState.TextureUnits.resize(_unit + 1, Unknown);
+
+        if (sState.TextureUnits[_unit] == _texture) {
+            Statistics::CountSkippedBind();
+            return;
+        }
+
+        glad_glBindTextureUnit(_unit, _texture);
+        sState.TextureUnits[_unit] = _texture;
+
+        Statistics::CountTextureBind();
+    }
+
+    void ForgetProgram(unsigned int _program) {
+
+        if (sState.program == _program)
+            sState.program = Unknown;
+    }
+    void ForgetBuffer(unsigned int _buffer) {
+
+        if (sState.ArrayBuffer == _buffer)
+            sState.ArrayBuffer = Unknown;
+        if (sState.ElementBuffer == _buffer)
+            sState.ElementBuffer = Unknown;
+    }
+    void ForgetVertexArray(unsigned int _vtxArray) {
+
+        if (sState.VertexArray == _vtxArray) {
+            sState.VertexArray = Unknown;
+            sState.ElementBuffer = Unknown;
+        }
+    }
+    void ForgetTexture(unsigned int _texture) {
+
+        for (auto& unit : sState.TextureUnits) {
+            if (unit == _texture)
+                unit = Unknown;
+        }
+    }
+
+    void ResetState() {
+
+        size_t units = sState.TextureUnits.size();
+
+        sState = StateCache();
+        sState.TextureUnits.assign(units, Unknown);
+    }
 }
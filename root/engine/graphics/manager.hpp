@@ -49,7 +49,24 @@ namespace Fleet::Core::Graphics::Manager {
     void BeginRender();
     void EndRender(GLFWwindow* window);
     
-    void DrawIndexed(const std::unique_ptr<VertexArray>& vtxArray, int _count = -1);
+    void DrawIndexed(const std::unique_ptr<VertexArray>& vtxArray, int _count = -1, int _BaseVertex = 0);
+    void DrawIndexedInstanced(const std::unique_ptr<VertexArray>& vtxArray, int _count, int _InstanceCount, int _BaseInstance = 0);
+
+    // GL state cache. Binds go through these and are skipped when the object is already bound. Only
+    // GL_ARRAY_BUFFER and GL_ELEMENT_ARRAY_BUFFER are cached, other buffer targets are always bound.
+    void UseProgram(unsigned int _program);
+    void BindBuffer(GLenum _target, unsigned int _buffer);
+    void BindVertexArray(unsigned int _vtxArray);
+    void BindTextureUnit(unsigned int _unit, unsigned int _texture);
+
+    // Call before deleting an object, a new object may get the same name
+    void ForgetProgram(unsigned int _program);
+    void ForgetBuffer(unsigned int _buffer);
+    void ForgetVertexArray(unsigned int _vtxArray);
+    void ForgetTexture(unsigned int _texture);
+
+    // Call after binding outside of the cache
+    void ResetState();
 }
 
 #endif // !FLEET_ENGINE_GRAPHICS_MANAGER
@@ -0,0 +1,220 @@
+// Fleet : engine/graphics/profiler.cpp (c) 2021 Andrew Woo
+
+/* Modified MIT License
+ *
+ * Copyright 2021 Andrew Woo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * Restrictions:
+ >  The Software may not be sold unless significant, mechanics changing modifications are made by the seller, or unless the buyer
+ >  understands an unmodified version of the Software is available elsewhere free of charge, and agrees to buy the Software given
+ >  this knowledge.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "profiler.hpp"
+
+// Include standard library
+#include <array>
+
+// Include dependencies
+#include <glad/glad.h>
+
+namespace Fleet::Core::Graphics::Profiler {
+
+    // Query objects of one frame. GL_TIME_ELAPSED queries can't nest, so the frame
+    // is measured with a pair of timestamps while each scene uses an elapsed query.
+    struct FrameQueries {
+
+        uint64_t frame = 0;
+        bool pending = false;
+
+        unsigned int begin = 0;
+        unsigned int end = 0;
+
+        std::vector<unsigned int> scenes;           // Pool, grows to the most scenes seen in a frame
+        std::vector<std::string> names;
+        size_t used = 0;
+    };
+
+    struct ProfilerData {
+
+        // Frames in flight before a query set is reused
+        static constexpr size_t Latency = 4;
+
+        std::array<FrameQueries, Latency> ring;
+        size_t current = 0;
+        uint64_t frame = 0;
+
+        bool created = false;
+        bool InFrame = false;
+        bool InScene = false;
+
+        FrameTiming last;
+        uint64_t dropped = 0;
+    };
+
+    static ProfilerData sData;
+
+    static bool Available(unsigned int _query) {
+
+        int available = 0;
+        glad_glGetQueryObjectiv(_query, GL_QUERY_RESULT_AVAILABLE, &available);
+
+        return available != 0;
+    }
+    static double Milliseconds(uint64_t _nanoseconds) {
+        return static_cast<double>(_nanoseconds) / 1000000.0;
+    }
+
+    // Reads a frame back if the GPU is done with it. Never waits.
+    static bool Resolve(FrameQueries& _queries) {
+
+        // Queries complete in order, once the closing timestamp is available everything before it is too
+        if (!_queries.pending || !Available(_queries.end))
+            return false;
+
+        uint64_t begin = 0;
+        uint64_t end = 0;
+
+        glad_glGetQueryObjectui64v(_queries.begin, GL_QUERY_RESULT, &begin);
+        glad_glGetQueryObjectui64v(_queries.end, GL_QUERY_RESULT, &end);
+
+        sData.last.frame = _queries.frame;
+        sData.last.ms = Milliseconds(end - begin);
+        sData.last.scenes.resize(_queries.used);
+
+        for (size_t i = 0; i < _queries.used; i++) {
+
+            uint64_t elapsed = 0;
+            glad_glGetQueryObjectui64v(_queries.scenes[i], GL_QUERY_RESULT, &elapsed);
+
+            sData.last.scenes[i].shader = _queries.names[i];
+            sData.last.scenes[i].ms = Milliseconds(elapsed);
+        }
+
+        _queries.pending = false;
+
+        return true;
+    }
+
+    void shutdown() {
+
+        if (!sData.created)
+            return;
+
+        for (auto& queries : sData.ring) {
+
+            glad_glDeleteQueries(1, &queries.begin);
+            glad_glDeleteQueries(1, &queries.end);
+
+            if (!queries.scenes.empty())
+                glad_glDeleteQueries(static_cast<int>(queries.scenes.size()), queries.scenes.data());
+
+            queries = FrameQueries();
+        }
+
+        sData.created = false;
+    }
+
+    void BeginFrame() {
+
+        if (!sData.created) {
+
+            for (auto& queries : sData.ring) {
+                glad_glCreateQueries(GL_TIMESTAMP, 1, &queries.begin);
+                glad_glCreateQueries(GL_TIMESTAMP, 1, &queries.end);
+            }
+
+            sData.created = true;
+        }
+
+        if (sData.InFrame)
+            EndFrame();
+
+        // Collect finished frames, oldest first
+        for (size_t i = 1; i <= sData.Latency; i++)
+            Resolve(sData.ring[(sData.current + i) % sData.Latency]);
+
+        sData.current = (sData.current + 1) % sData.Latency;
+        FrameQueries& queries = sData.ring[sData.current];
+
+        // Still running on the GPU after Latency frames, drop it rather than stall
+        if (queries.pending)
+            sData.dropped++;
+
+        queries.frame = sData.frame++;
+        queries.pending = false;
+        queries.used = 0;
+
+        glad_glQueryCounter(queries.begin, GL_TIMESTAMP);
+
+        sData.InFrame = true;
+    }
+    void EndFrame() {
+
+        if (!sData.InFrame)
+            return;
+
+        if (sData.InScene)
+            EndScene();
+
+        FrameQueries& queries = sData.ring[sData.current];
+
+        glad_glQueryCounter(queries.end, GL_TIMESTAMP);
+        queries.pending = true;
+
+        sData.InFrame = false;
+    }
+
+    void BeginScene(const std::string& _shader) {
+
+        if (!sData.InFrame)
+            return;
+
+        if (sData.InScene)
+            EndScene();
+
+        FrameQueries& queries = sData.ring[sData.current];
+
+        if (queries.used == queries.scenes.size()) {
+
+            unsigned int query = 0;
+            glad_glCreateQueries(GL_TIME_ELAPSED, 1, &query);
+
+            queries.scenes.push_back(query);
+            queries.names.emplace_back();
+        }
+
+        queries.names[queries.used] = _shader;
+        glad_glBeginQuery(GL_TIME_ELAPSED, queries.scenes[queries.used]);
+
+        sData.InScene = true;
+    }
+    void EndScene() {
+
+        if (!sData.InScene)
+            return;
+
+        glad_glEndQuery(GL_TIME_ELAPSED);
+        sData.ring[sData.current].used++;
+
+        sData.InScene = false;
+    }
+
+    const FrameTiming& GetLastFrame() {
+        return sData.last;
+    }
+    const uint64_t GetDroppedFrames() {
+        return sData.dropped;
+    }
+}
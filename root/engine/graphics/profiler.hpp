@@ -0,0 +1,61 @@
+// Fleet : engine/graphics/profiler.hpp (c) 2021 Andrew Woo
+
+/* Modified MIT License
+ *
+ * Copyright 2021 Andrew Woo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * Restrictions:
+ >  The Software may not be sold unless significant, mechanics changing modifications are made by the seller, or unless the buyer
+ >  understands an unmodified version of the Software is available elsewhere free of charge, and agrees to buy the Software given
+ >  this knowledge.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#ifndef FLEET_ENGINE_GRAPHICS_PROFILER
+#define FLEET_ENGINE_GRAPHICS_PROFILER
+
+// Include standard library
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace Fleet::Core::Graphics::Profiler {
+
+    // GPU time of a frame and its scenes, in milliseconds. Results arrive a few frames late.
+    struct SceneTiming {
+        std::string shader;
+        double ms = 0;
+    };
+
+    struct FrameTiming {
+        uint64_t frame = 0;
+        double ms = 0;
+        std::vector<SceneTiming> scenes;
+    };
+
+    void shutdown();
+
+    // Frame control (GL thread only)
+    void BeginFrame();
+    void EndFrame();
+    void BeginScene(const std::string& _shader);
+    void EndScene();
+
+    // Getters
+    const FrameTiming& GetLastFrame();          // Most recent frame with available results
+    const uint64_t GetDroppedFrames();          // Frames whose results were still pending when their queries were reused
+}
+
+#endif // !FLEET_ENGINE_GRAPHICS_PROFILER
@@ -26,23 +26,57 @@
 #include "renderer.hpp"
 
 // Include standard library
+#include <cstring>
 #include <iostream>
 #include <vector>
+#include <algorithm>
 #include <unordered_map>
 
 // Include dependencies
 #include <GLM/glm/gtc/matrix_transform.hpp>
+#include <glad/glad.h>
 #include <ASWL/experimental.hpp>
+#include <ASWL/logger.hpp>
 
 // Include Fleet libraries
 #include "manager.hpp"
 #include "shaders.hpp"
 #include "vertex.hpp"
 #include "buffer.hpp"
+#include "statistics.hpp"
+#include "text.hpp"
+#include "profiler.hpp"
 #include "../math/math.hpp"
 
 namespace Fleet::Core::Graphics::Renderer {
 
+    struct SortEntry {
+        uint64_t key;               // layer (8) | texture (16) | depth (32)
+        uint32_t index;             // arena (8) | command (24)
+    };
+
+    // Library shader with the handles of the uniforms the renderer sets per program
+    struct SceneShader {
+        std::shared_ptr<Shader> shader;
+
+        Uniform SDF;
+    };
+
+    // std140 "Scene" uniform block at binding 0, one slot per camera
+    struct SceneBlock {
+        glm::mat4 ViewProjection;
+        glm::mat4 Transform;
+        glm::vec4 Color;
+        glm::vec2 Resolution;
+        glm::vec2 padding;
+    };
+
+    struct GlyphRun {
+        std::shared_ptr<Font> font;
+        uint32_t first;             // First instance in __glyph_instances
+        uint32_t count;
+    };
+
     struct RendererData {
 
         RendererData() = default;
@@ -52,37 +86,105 @@ namespace Fleet::Core::Graphics::Renderer {
         const uint32_t MaxVertices = MaxQuads * 4;
         const uint32_t MaxIndices = MaxQuads * 6;
 
-        // Shaders
+        // Max sprite instances per draw call
+        const uint32_t MaxSprites = 10000;
+
+        // Max GPU text glyphs per flush
+        const uint32_t MaxGlyphInstances = 20000;
+
+        // Sort entry index split, arenas per scene and commands per arena
+        const uint32_t MaxArenas = Renderer::MaxArenas;
+        const uint32_t ArenaShift = 24;
+        const uint32_t CommandMask = Renderer::MaxArenaCommands - 1;
+
+        // Number of fenced regions in the streaming vertex buffers
+        const uint32_t StreamRegions = 3;
+
+        // Shaders, compiled on first use. Scene shaders keep their uniform handles next to them.
         std::unique_ptr<ShaderLibrary> __shader_library;
+        std::unordered_map<std::string, SceneShader> __scene_shaders;
+        SceneShader __text_gpu_shader;
+        SceneShader __static_text_shader;
+
+        // Scene uniform buffer. Each camera keeps its own slot, so switching scenes only rebinds the range and
+        // a slot is only rewritten when its camera moved. Past MaxCameras, slots are reused in turn.
+        const uint32_t MaxCameras = 16;
+
+        unsigned int __scene_ubo = 0;
+        uint32_t __scene_ubo_stride = 0;
+        std::vector<const OrthoCam*> __camera_slots;
+        std::vector<SceneBlock> __camera_blocks;
+        uint32_t __camera_next = 0;
         
         // Vertex Array Data
         std::unique_ptr<VertexArray> __quad_vtx_array;
         std::shared_ptr<VertexBuffer> __quad_vtx_buffer;
+        std::shared_ptr<IndexBuffer> __quad_index_buffer;
         unsigned int __quad_index_count = 0;
+
+        // Instanced Sprite Data
+        std::unique_ptr<VertexArray> __sprite_vtx_array;
+        std::shared_ptr<VertexBuffer> __sprite_inst_buffer;
+        unsigned int __sprite_count = 0;
+
+        // GPU Text Data (glyph instances, one run per font). Instances are staged for the whole scene and only
+        // copied into the ring in EndScene.
+        std::unique_ptr<VertexArray> __glyph_vtx_array;
+        std::shared_ptr<VertexBuffer> __glyph_inst_buffer;
+        Graphics::GlyphInstance* __glyph_buf_base = nullptr;
+        std::vector<Graphics::GlyphInstance> __glyph_instances;
+        std::vector<GlyphRun> __glyph_runs;
         
         // Texture storage
         int __max_texture_units = 16;
         int __texslot = 1;
 
         std::shared_ptr<Texture> __white;
-        std::vector<int> __samplers;
         ASWL::eXperimental::UnorderedSizedMap<int, std::shared_ptr<Texture>> __bound_texture_map;
         std::vector<std::shared_ptr<Texture>> __bound_texture_array;
 
-        // Vertex data storage
+        // Vertex data storage (points into the mapped region of __quad_vtx_buffer)
         Graphics::Vertex* __quad_vtx_buf_base = nullptr;
         Graphics::Vertex* __quad_vtx_buf_ptr = nullptr;
 
+        // Sprite instance storage (points into the mapped region of __sprite_inst_buffer)
+        Graphics::SpriteInstance* __sprite_buf_base = nullptr;
+        Graphics::SpriteInstance* __sprite_buf_ptr = nullptr;
+
+        // Render queue (deferred, sorted at EndScene). __arena records the GL thread's own submissions,
+        // __arena_textures maps each submitted arena's local texture indices to scene indices.
+        CommandArena __arena;
+        std::vector<const CommandArena*> __arenas;
+        std::vector<std::vector<uint16_t>> __arena_textures;
+        std::vector<SortEntry> __sort_keys;
+        std::vector<SortEntry> __sort_scratch;
+
+        // Static text drawn at the end of the scene
+        std::vector<StaticText*> __static_text;
+
+        // Current scene, static and GPU text rebind the scene shader after drawing with their own
+        std::shared_ptr<Shader> __scene_shader;
+
+        // Scene textures. Index 0 is the white texture, __scene_texture_lookup maps texture IDs to scene indices + 1
+        // and __scene_texture_slots maps scene indices to the slot they are bound to in the current batch (0 -> unbound).
+        std::vector<std::shared_ptr<Texture>> __scene_textures;
+        std::vector<uint16_t> __scene_texture_lookup;
+        std::vector<int> __scene_texture_slots;
+
+        // Scene index of the texture array bound to unit 1 in the current batch (0 -> none)
+        uint16_t __scene_array = 0;
+
         // Other Data
         glm::vec2 WindowSize = { 1000, 618 };
-        glm::vec2 DefaultTexCoords[4] = { { 0.f, 0.f }, { 1.f, 0.f }, { 1.f, 1.f }, { 0.f, 1.f } };
+        QuadTexCoords DefaultTexCoords = { glm::vec2(0.f, 0.f), glm::vec2(1.f, 0.f), glm::vec2(1.f, 1.f), glm::vec2(0.f, 1.f) };
+        glm::vec4 DefaultTexRect = { 0.f, 0.f, 1.f, 1.f };
     };
 
     static RendererData sData;
 
-    std::vector<glm::vec3> CalculateVertexPositions(const glm::vec3& _position, const glm::vec2& _size) {
+    QuadVertices CalculateVertexPositions(const glm::vec3& _position, const glm::vec2& _size) {
 
-        std::vector<glm::vec3> __vp(4); // = { glm::vec3(), glm::vec3(), glm::vec3(), glm::vec3() };
+        QuadVertices __vp;
 
         // Counter clockwise vertices
         __vp[0] = { _position.x - (_size.x / 2), _position.y - (_size.y / 2), _position.z };        // Bottom Left
@@ -92,16 +194,8 @@ namespace Fleet::Core::Graphics::Renderer {
 
         return __vp;
     }
-    std::vector<glm::vec3>  RotateVertices(const std::vector<glm::vec3>& _vertices, const glm::vec3& _position, const float _rotation) {
-
-        std::vector<glm::vec3> __rv(4);
-
-        __rv[0] = Core::Math::RotatePoint(_vertices[0], _position, _rotation);
-        __rv[1] = Core::Math::RotatePoint(_vertices[1], _position, _rotation);
-        __rv[2] = Core::Math::RotatePoint(_vertices[2], _position, _rotation);
-        __rv[3] = Core::Math::RotatePoint(_vertices[3], _position, _rotation);
-
-        return __rv;
+    QuadVertices RotateVertices(const QuadVertices& _vertices, const glm::vec3& _position, const float _rotation) {
+        return Core::Math::RotatePoints(_vertices, _position, _rotation);
     }
 
     void init(const glm::vec2& _WindowSize, int _MaxTextureUnits) {
@@ -111,17 +205,19 @@ namespace Fleet::Core::Graphics::Renderer {
 
         // Create Vertex Array (dynamic)
         sData.__quad_vtx_array = std::make_unique<VertexArray>();
-        sData.__quad_vtx_buf_base = new Graphics::Vertex[sData.MaxVertices];
-        sData.__quad_vtx_buf_ptr = sData.__quad_vtx_buf_base;
 
-        // Create Vertex Buffer (dynamic)
+        // Create Vertex Buffer (persistent mapped ring, quads are written directly into GPU visible memory)
         sData.__quad_vtx_buffer = std::make_shared<VertexBuffer>();
-        sData.__quad_vtx_buffer->Create(sData.MaxVertices * sizeof(Graphics::Vertex));
+        sData.__quad_vtx_buffer->CreatePersistent(sData.MaxVertices * sizeof(Graphics::Vertex), sData.StreamRegions);
+
+        sData.__quad_vtx_buf_base = static_cast<Graphics::Vertex*>(sData.__quad_vtx_buffer->MapRegion());
+        sData.__quad_vtx_buf_ptr = sData.__quad_vtx_buf_base;
 
         sData.__quad_vtx_buffer->SetLayout({ { ShaderDataType::Float3, "a_Position" },
                                              { ShaderDataType::Float2, "a_TexCoord" },
                                              { ShaderDataType::Float4, "a_Color"},
-                                             { ShaderDataType::Float, "a_TexSlot"} });
+                                             { ShaderDataType::Float, "a_TexSlot"},
+                                             { ShaderDataType::Float, "a_Mode"} });
 
         sData.__quad_vtx_array->AddVertexBuffer(sData.__quad_vtx_buffer);
 
@@ -142,18 +238,69 @@ namespace Fleet::Core::Graphics::Renderer {
             offset += 4;
         }
 
-        std::shared_ptr<IndexBuffer> __quad_ib = std::make_shared<IndexBuffer>(__quad_indices, sData.MaxIndices * sizeof(uint32_t));
-        sData.__quad_vtx_array->SetIndexBuffer(__quad_ib);
+        sData.__quad_index_buffer = std::make_shared<IndexBuffer>(__quad_indices, sData.MaxIndices * sizeof(uint32_t));
+        sData.__quad_vtx_array->SetIndexBuffer(sData.__quad_index_buffer);
+
+        // Create Sprite Instance Array (dynamic). Corners are generated in the vertex shader from the first quad's indices.
+        sData.__sprite_vtx_array = std::make_unique<VertexArray>();
+
+        sData.__sprite_inst_buffer = std::make_shared<VertexBuffer>();
+        sData.__sprite_inst_buffer->CreatePersistent(sData.MaxSprites * sizeof(Graphics::SpriteInstance), sData.StreamRegions);
+
+        sData.__sprite_buf_base = static_cast<Graphics::SpriteInstance*>(sData.__sprite_inst_buffer->MapRegion());
+        sData.__sprite_buf_ptr = sData.__sprite_buf_base;
+
+        sData.__sprite_inst_buffer->SetLayout({ { ShaderDataType::Float3, "i_Position", false, 1 },
+                                                { ShaderDataType::Float2, "i_Size", false, 1 },
+                                                { ShaderDataType::Float, "i_Rotation", false, 1 },
+                                                { ShaderDataType::Float4, "i_Color", false, 1 },
+                                                { ShaderDataType::Float4, "i_TexRect", false, 1 },
+                                                { ShaderDataType::Float, "i_TexSlot", false, 1 } });
+
+        sData.__sprite_vtx_array->AddVertexBuffer(sData.__sprite_inst_buffer);
+        sData.__sprite_vtx_array->SetIndexBuffer(sData.__quad_index_buffer);
+
+        // Create GPU Text Instance Array (dynamic). Quads are built from the font's glyph table in the vertex shader.
+        sData.__glyph_vtx_array = std::make_unique<VertexArray>();
+
+        sData.__glyph_inst_buffer = std::make_shared<VertexBuffer>();
+        sData.__glyph_inst_buffer->CreatePersistent(sData.MaxGlyphInstances * sizeof(Graphics::GlyphInstance), sData.StreamRegions);
+
+        sData.__glyph_buf_base = static_cast<Graphics::GlyphInstance*>(sData.__glyph_inst_buffer->MapRegion());
+        sData.__glyph_instances.reserve(sData.MaxGlyphInstances);
+
+        sData.__glyph_inst_buffer->SetLayout({ { ShaderDataType::Float3, "i_Pen", false, 1 },
+                                               { ShaderDataType::Int, "i_Glyph", false, 1 },
+                                               { ShaderDataType::Int, "i_Color", false, 1 },
+                                               { ShaderDataType::Int, "i_Scale", false, 1 } });
+
+        sData.__glyph_vtx_array->AddVertexBuffer(sData.__glyph_inst_buffer);
+        sData.__glyph_vtx_array->SetIndexBuffer(sData.__quad_index_buffer);
+
+        // Texture data, samplers are bound to their units in the shaders (layout(binding)). The sampling switch
+        // handles units in groups of 4, GL 4.6 guarantees at least 16.
+        sData.__max_texture_units = std::clamp(_MaxTextureUnits, 4, 32) & ~3;
+
+        // Initialize Shader Library, sampler arrays are sized to the device
+        ShaderDefines __defines = { { "FLEET_MAX_TEXTURES", std::to_string(sData.__max_texture_units) } };
+        sData.__shader_library = std::make_unique<ShaderLibrary>(ShaderLibrary("assets/shaders/.shaders", __defines));
+
+        // Hand every shader to the driver's compiler threads, the first frame only waits for the ones it uses
+        sData.__shader_library->Prewarm();
 
-        // Initialize Shader Library
-        sData.__shader_library = std::make_unique<ShaderLibrary>(ShaderLibrary("assets/shaders/.shaders"));
         sData.__quad_vtx_array->Bind();
 
-        // Texture data
-        sData.__max_texture_units = (_MaxTextureUnits > 32) ? 32 : _MaxTextureUnits;
+        // Create Scene Uniform Buffer, slots are aligned so each can be bound on its own
+        GLint alignment = 256;
+        glad_glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
 
-        for (int i = 0; i < sData.__max_texture_units; i++)
-            sData.__samplers.push_back(i);
+        sData.__scene_ubo_stride = static_cast<uint32_t>((sizeof(SceneBlock) + alignment - 1) / alignment * alignment);
+
+        glad_glCreateBuffers(1, &sData.__scene_ubo);
+        glad_glNamedBufferStorage(sData.__scene_ubo, sData.MaxCameras * sData.__scene_ubo_stride, nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+        sData.__camera_slots.assign(sData.MaxCameras, nullptr);
+        sData.__camera_blocks.assign(sData.MaxCameras, SceneBlock());
 
         // Create 1x1 White Texture
         uint32_t __white_data = 0xffffffff;
@@ -166,24 +313,55 @@ namespace Fleet::Core::Graphics::Renderer {
         for (int i = 0; i < sData.__max_texture_units; i++)
             sData.__bound_texture_array[i] = sData.__white;
 
+        sData.__scene_textures.push_back(sData.__white);
+        sData.__scene_texture_slots.push_back(0);
+
         delete[] __quad_indices;
     }
     void shutdown() {
-        delete[] sData.__quad_vtx_buf_base;
+
+        // Mapped memory is released with the vertex buffer
+        sData.__quad_vtx_buf_base = nullptr;
+        sData.__quad_vtx_buf_ptr = nullptr;
+        sData.__sprite_buf_base = nullptr;
+        sData.__sprite_buf_ptr = nullptr;
+        sData.__glyph_buf_base = nullptr;
+        sData.__glyph_instances.clear();
+
+        sData.__glyph_runs.clear();
+        sData.__scene_shader.reset();
+        sData.__scene_shaders.clear();
+        sData.__text_gpu_shader = {};
+        sData.__static_text_shader = {};
+
+        if (sData.__scene_ubo != 0)
+            glad_glDeleteBuffers(1, &sData.__scene_ubo);
+
+        sData.__scene_ubo = 0;
+        sData.__camera_slots.clear();
+        sData.__camera_blocks.clear();
     }
 
     void SetWindowSize(const glm::vec2& _WindowSize) {
         sData.WindowSize = _WindowSize;
     }
 
+    const std::shared_ptr<IndexBuffer>& GetQuadIndexBuffer() {
+        return sData.__quad_index_buffer;
+    }
+    const uint32_t GetMaxQuads() {
+        return sData.MaxQuads;
+    }
+
     // Add to batch
-    void AddQuad(const std::vector<glm::vec3>& _vertices, const glm::vec4& _color, glm::vec2 _TexCoords[4], const float _texslot) {
+    void AddQuad(const QuadVertices& _vertices, const glm::vec4& _color, const QuadTexCoords& _TexCoords, const float _texslot, const float _mode) {
 
         // Bottom Left
         sData.__quad_vtx_buf_ptr->position = _vertices[0];
         sData.__quad_vtx_buf_ptr->texcoord = _TexCoords[0];
         sData.__quad_vtx_buf_ptr->color = _color;
         sData.__quad_vtx_buf_ptr->texslot = _texslot;
+        sData.__quad_vtx_buf_ptr->mode = _mode;
         sData.__quad_vtx_buf_ptr++;
 
         // Bottom Right
@@ -191,6 +369,7 @@ namespace Fleet::Core::Graphics::Renderer {
         sData.__quad_vtx_buf_ptr->texcoord = _TexCoords[1];
         sData.__quad_vtx_buf_ptr->color = _color;
         sData.__quad_vtx_buf_ptr->texslot = _texslot;
+        sData.__quad_vtx_buf_ptr->mode = _mode;
         sData.__quad_vtx_buf_ptr++;
 
         // Top Right
@@ -198,6 +377,7 @@ namespace Fleet::Core::Graphics::Renderer {
         sData.__quad_vtx_buf_ptr->texcoord = _TexCoords[2];
         sData.__quad_vtx_buf_ptr->color = _color;
         sData.__quad_vtx_buf_ptr->texslot = _texslot;
+        sData.__quad_vtx_buf_ptr->mode = _mode;
         sData.__quad_vtx_buf_ptr++;
 
         // Top Left
@@ -205,159 +385,857 @@ namespace Fleet::Core::Graphics::Renderer {
         sData.__quad_vtx_buf_ptr->texcoord = _TexCoords[3];
         sData.__quad_vtx_buf_ptr->color = _color;
         sData.__quad_vtx_buf_ptr->texslot = _texslot;
+        sData.__quad_vtx_buf_ptr->mode = _mode;
         sData.__quad_vtx_buf_ptr++;
 
         sData.__quad_index_count += 6;
+
+        Statistics::CountQuads();
     }
+    void AddSprite(const glm::vec3& _position, const glm::vec2& _size, const float _rotation, const glm::vec4& _color, const glm::vec4& _TexRect, const float _texslot) {
 
-    // Render commands
-    void StartScene(const std::unique_ptr<OrthoCam>& camera, const std::string& _shader) {
+        sData.__sprite_buf_ptr->position = _position;
+        sData.__sprite_buf_ptr->size = _size;
+        sData.__sprite_buf_ptr->rotation = _rotation;
+        sData.__sprite_buf_ptr->color = _color;
+        sData.__sprite_buf_ptr->texrect = _TexRect;
+        sData.__sprite_buf_ptr->texslot = _texslot;
+        sData.__sprite_buf_ptr++;
+
+        sData.__sprite_count++;
 
-        sData.__shader_library->GetMap().find(_shader)->second->Bind();
-        sData.__shader_library->GetMap().find(_shader)->second->SetInt1v("u_Textures", 32, sData.__samplers.data());
-        sData.__shader_library->GetMap().find(_shader)->second->SetMat4("u_ViewProjection", camera->GetViewProjectionMatrix());
-        sData.__shader_library->GetMap().find(_shader)->second->SetFloat4("u_Color", glm::vec4(1.f));
-        sData.__shader_library->GetMap().find(_shader)->second->SetMat4("u_Transform", glm::mat4(1.f));
+        Statistics::CountSprites();
+    }
+
+    // Scene texture registry
+    static uint16_t RegisterTexture(const std::shared_ptr<Texture>& _texture) {
+
+        unsigned int id = _texture->GetTextureID();
+
+        if (id >= sData.__scene_texture_lookup.size())
+            sData.__scene_texture_lookup.resize(id + 1, 0);
+
+        if (sData.__scene_texture_lookup[id] == 0) {
+
+            sData.__scene_textures.push_back(_texture);
+            sData.__scene_texture_slots.push_back(0);
+            sData.__scene_texture_lookup[id] = static_cast<uint16_t>(sData.__scene_textures.size() - 1);
+        }
+
+        return sData.__scene_texture_lookup[id];
+    }
+    static void ResetSceneTextures() {
+
+        for (size_t i = 1; i < sData.__scene_textures.size(); i++)
+            sData.__scene_texture_lookup[sData.__scene_textures[i]->GetTextureID()] = 0;
+
+        sData.__scene_textures.resize(1);
+        sData.__scene_texture_slots.resize(1);
+    }
+
+    // Batch slot of a scene texture, flushes when every slot is taken
+    static int GetTextureSlot(uint16_t _texture) {
+
+        if (_texture == 0)
+            return 0;
+
+        int& slot = sData.__scene_texture_slots[_texture];
+
+        if (slot == 0) {
+
+            // Unit 1 holds a texture array, quads queued against it have to be drawn first
+            if (sData.__texslot > sData.__max_texture_units - 1 || sData.__scene_array != 0)
+                FlushScene();
+
+            sData.__bound_texture_array[sData.__texslot] = sData.__scene_textures[_texture];
+            slot = sData.__texslot++;
+        }
+
+        return slot;
     }
-    void FlushScene() {
 
-        if (sData.__quad_index_count <= 0)
+    // Texture arrays are always bound to unit 1 and the layer takes the place of the slot, so array batches
+    // only flush when the array changes. Sorting by texture keeps every layer of an array in the same batch.
+    static float GetArrayLayer(uint16_t _texture, float _layer) {
+
+        if (sData.__scene_array != _texture) {
+
+            // Unit 1 is about to change, draw what was queued against the previous array or the slot textures
+            if (sData.__scene_array != 0 || sData.__texslot > 1)
+                FlushScene();
+
+            sData.__bound_texture_array[1] = sData.__scene_textures[_texture];
+            sData.__texslot = 2;
+            sData.__scene_array = _texture;
+        }
+
+        return _layer;
+    }
+
+    // Sort keys
+    static uint32_t DepthBits(float _depth) {
+
+        // Maps float ordering onto unsigned integer ordering
+        uint32_t bits = 0;
+        std::memcpy(&bits, &_depth, sizeof(float));
+
+        return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    }
+    // A scene draws with a single shader, so the key only orders layers, textures and depth. The radix sort is
+    // stable and entries are added in submission order, equal keys keep it.
+    static uint64_t SortKey(float _depth, uint16_t _texture) {
+
+        uint64_t layer = static_cast<uint64_t>(std::clamp(static_cast<int>(_depth * 10.f + 0.001f), 0, 255));
+
+        return (layer << 48) | (static_cast<uint64_t>(_texture) << 32) | DepthBits(_depth);
+    }
+
+    // LSD radix sort, 8 bits per pass. Passes where every key shares the same digit are skipped.
+    static void RadixSort(std::vector<SortEntry>& _entries, std::vector<SortEntry>& _scratch) {
+
+        const size_t count = _entries.size();
+
+        if (count < 2)
             return;
 
-        for (int i = 0; i < sData.__texslot; i++)
-            sData.__bound_texture_array[i]->Bind(i);
+        _scratch.resize(count);
 
-        uint32_t __size = reinterpret_cast<uint8_t*>(sData.__quad_vtx_buf_ptr) - 
-                          reinterpret_cast<uint8_t*>(sData.__quad_vtx_buf_base);
+        SortEntry* src = _entries.data();
+        SortEntry* dst = _scratch.data();
 
-        sData.__quad_vtx_buffer->SetData(sData.__quad_vtx_buf_base, __size);
+        for (int shift = 0; shift < 64; shift += 8) {
 
-        Manager::DrawIndexed(sData.__quad_vtx_array, sData.__quad_index_count);
+            uint32_t histogram[256] = {};
 
-        sData.__texslot = 1;
-        sData.__quad_index_count = 0;
-        sData.__quad_vtx_buf_ptr = sData.__quad_vtx_buf_base;
+            for (size_t i = 0; i < count; i++)
+                histogram[(src[i].key >> shift) & 0xFF]++;
+
+            if (histogram[(src[0].key >> shift) & 0xFF] == count)
+                continue;
+
+            uint32_t offset = 0;
+            for (auto& bucket : histogram) {
+                uint32_t size = bucket;
+                bucket = offset;
+                offset += size;
+            }
+
+            for (size_t i = 0; i < count; i++)
+                dst[histogram[(src[i].key >> shift) & 0xFF]++] = src[i];
+
+            std::swap(src, dst);
+        }
+
+        if (src != _entries.data())
+            std::copy(src, src + count, _entries.data());
     }
-    void EndScene() {
-        FlushScene();
+
+    // Sort and emit the render queue into as few batches as possible
+    static void SubmitQueue() {
+
+        sData.__sort_keys.clear();
+        for (uint32_t a = 0; a < sData.__arenas.size(); a++) {
+
+            const auto& quads = sData.__arenas[a]->GetQuads();
+            const auto& textures = sData.__arena_textures[a];
+
+            for (uint32_t i = 0; i < quads.size(); i++)
+                sData.__sort_keys.push_back({ SortKey(quads[i].vertices[0].z, textures[quads[i].texture]), (a << sData.ArenaShift) | i });
+        }
+
+        RadixSort(sData.__sort_keys, sData.__sort_scratch);
+
+        for (const auto& entry : sData.__sort_keys) {
+
+            uint32_t arena = entry.index >> sData.ArenaShift;
+
+            const QuadCommand& command = sData.__arenas[arena]->GetQuads()[entry.index & sData.CommandMask];
+            uint16_t texture = sData.__arena_textures[arena][command.texture];
+
+            if (sData.__quad_index_count >= sData.MaxIndices)
+                FlushScene();
+
+            float texslot = (command.layer < 0.f) ? static_cast<float>(GetTextureSlot(texture)) : GetArrayLayer(texture, command.layer);
+
+            AddQuad(command.vertices, command.color, command.texcoords, texslot, command.mode);
+        }
+
+        sData.__sort_keys.clear();
+        for (uint32_t a = 0; a < sData.__arenas.size(); a++) {
+
+            const auto& sprites = sData.__arenas[a]->GetSprites();
+            const auto& textures = sData.__arena_textures[a];
+
+            for (uint32_t i = 0; i < sprites.size(); i++)
+                sData.__sort_keys.push_back({ SortKey(sprites[i].instance.position.z, textures[sprites[i].texture]), (a << sData.ArenaShift) | i });
+        }
+
+        RadixSort(sData.__sort_keys, sData.__sort_scratch);
+
+        for (const auto& entry : sData.__sort_keys) {
+
+            uint32_t arena = entry.index >> sData.ArenaShift;
+
+            const SpriteCommand& command = sData.__arenas[arena]->GetSprites()[entry.index & sData.CommandMask];
+            const SpriteInstance& instance = command.instance;
+            uint16_t texture = sData.__arena_textures[arena][command.texture];
+
+            if (sData.__sprite_count >= sData.MaxSprites)
+                FlushScene();
+
+            float texslot = (command.layer < 0.f) ? static_cast<float>(GetTextureSlot(texture)) : GetArrayLayer(texture, command.layer);
+
+            AddSprite(instance.position, instance.size, instance.rotation, instance.color, instance.texrect, texslot);
+        }
+
+        sData.__arenas.clear();
+    }
+
+    // Command arena
+    CommandArena::CommandArena(size_t _reserve) {
+
+        quads.reserve(_reserve);
+        sprites.reserve(_reserve);
+
+        textures.push_back(nullptr);
+    }
+
+    void CommandArena::clear() {
+
+        quads.clear();
+        sprites.clear();
+
+        textures.resize(1);
+        last = 0;
+
+        // Evict text layouts that haven't been used for a while
+        if (++generation % LayoutLifetime == 0) {
+
+            for (auto it = layouts.begin(); it != layouts.end(); ) {
+
+                if (generation - it->second.used > LayoutLifetime)
+                    spare.push_back(layouts.extract(it++));
+                else
+                    ++it;
+            }
+        }
+    }
+
+    const std::vector<QuadCommand>& CommandArena::GetQuads() const {
+        return quads;
+    }
+    const std::vector<SpriteCommand>& CommandArena::GetSprites() const {
+        return sprites;
+    }
+    const std::vector<std::shared_ptr<Texture>>& CommandArena::GetTextures() const {
+        return textures;
+    }
+
+    // Arena local texture index. Consecutive submissions usually share a texture, so the last hit is checked first.
+    uint16_t CommandArena::Local(const std::shared_ptr<Texture>& _texture) {
+
+        if (last != 0 && textures[last] == _texture)
+            return last;
+
+        for (size_t i = 1; i < textures.size(); i++) {
+            if (textures[i] == _texture)
+                return last = static_cast<uint16_t>(i);
+        }
+
+        textures.push_back(_texture);
+
+        return last = static_cast<uint16_t>(textures.size() - 1);
     }
 
     // Draw static quad functions
-    void DrawQuad(const render_data& _data) {
+    void CommandArena::DrawQuad(const render_data& _data) {
 
         if (_data.rotation != 0) {
             auto cvp = CalculateVertexPositions(_data.position, _data.scale);
-            AddQuad(RotateVertices(cvp, _data.position, _data.rotation), _data.color, sData.DefaultTexCoords);
+            quads.push_back({ RotateVertices(cvp, _data.position, _data.rotation), sData.DefaultTexCoords, _data.color, 0 });
         }
         else
-            AddQuad(CalculateVertexPositions(_data.position, _data.scale), _data.color, sData.DefaultTexCoords);
+            quads.push_back({ CalculateVertexPositions(_data.position, _data.scale), sData.DefaultTexCoords, _data.color, 0 });
     }
 
     // Render texture functions
-    void RenderTexture(const render_data& _data, const std::shared_ptr<Texture>& _texture) {
+    void CommandArena::RenderTexture(const render_data& _data, const std::shared_ptr<Texture>& _texture) {
 
-        if (sData.__texslot > sData.__max_texture_units - 1 || sData.__quad_index_count > sData.MaxIndices)
-            FlushScene();
+        uint16_t texture = Local(_texture);
 
-        int texslot = 0;
+        float t_Width = static_cast<float>(_texture->GetDimensions().x) * _data.scale.x;
+        float t_Height = static_cast<float>(_texture->GetDimensions().y) * _data.scale.y;
 
-        for(int i = 1; i < sData.__texslot; i++) {
-            if (*sData.__bound_texture_array[i].get() == *_texture.get()) {
-                texslot = i;
-                break;
-            }
+        if (_data.rotation != 0.f) {
+            auto cvp = CalculateVertexPositions(_data.position, {t_Width, t_Height});
+            quads.push_back({ RotateVertices(cvp, _data.position, _data.rotation), sData.DefaultTexCoords, _data.color, texture });
         }
-        if (texslot == 0) {
-            sData.__bound_texture_array[sData.__texslot] = _texture;
-            texslot = sData.__texslot++;
+        else
+            quads.push_back({ CalculateVertexPositions(_data.position, { t_Width, t_Height }), sData.DefaultTexCoords, { 1.f, 1.f, 1.f, 1.f }, texture });
+    }
+    void CommandArena::RenderTexture(const render_data& _data, const std::shared_ptr<AtlasRegion>& _region) {
+
+        // Failed loads return an empty region, they were logged when loading
+        if (!_region)
+            return;
+
+        uint16_t texture = Local(_region->page);
+
+        glm::vec2 size = _region->dimensions * _data.scale;
+
+        if (_data.rotation != 0.f) {
+            auto cvp = CalculateVertexPositions(_data.position, size);
+            quads.push_back({ RotateVertices(cvp, _data.position, _data.rotation), _region->TexCoords, _data.color, texture });
         }
+        else
+            quads.push_back({ CalculateVertexPositions(_data.position, size), _region->TexCoords, _data.color, texture });
+    }
+    void CommandArena::RenderTexture(const render_data& _data, const std::shared_ptr<TextureLayer>& _layer) {
 
-        float t_Width = static_cast<float>(_texture->GetDimensions().x) * _data.scale.x;
-        float t_Height = static_cast<float>(_texture->GetDimensions().y) * _data.scale.y;
+        // Failed loads return an empty region, they were logged when loading
+        if (!_layer)
+            return;
+
+        uint16_t texture = Local(_layer->array);
+
+        glm::vec2 size = _layer->dimensions * _data.scale;
 
         if (_data.rotation != 0.f) {
-            auto cvp = CalculateVertexPositions(_data.position, {t_Width, t_Height});
-            AddQuad(RotateVertices(cvp, _data.position, _data.rotation), _data.color, sData.DefaultTexCoords, static_cast<float>(texslot));
+            auto cvp = CalculateVertexPositions(_data.position, size);
+            quads.push_back({ RotateVertices(cvp, _data.position, _data.rotation), _layer->TexCoords, _data.color, texture, _layer->layer });
         }
         else
-            AddQuad(CalculateVertexPositions(_data.position, { t_Width, t_Height }), { 1.f, 1.f, 1.f, 1.f }, sData.DefaultTexCoords, static_cast<float>(texslot));
+            quads.push_back({ CalculateVertexPositions(_data.position, size), _layer->TexCoords, _data.color, texture, _layer->layer });
+    }
+
+    // Render sprite functions
+    void CommandArena::RenderSprite(const render_data& _data, const std::shared_ptr<Texture>& _texture) {
+
+        uint16_t texture = Local(_texture);
+
+        glm::vec2 size = _texture->GetDimensions() * _data.scale;
+
+        sprites.push_back({ { _data.position, size, _data.rotation, _data.color, sData.DefaultTexRect, 0.f }, texture });
+    }
+    void CommandArena::RenderSprite(const render_data& _data, const std::shared_ptr<AtlasRegion>& _region) {
+
+        // Failed loads return an empty region, they were logged when loading
+        if (!_region)
+            return;
+
+        uint16_t texture = Local(_region->page);
+
+        glm::vec2 size = _region->dimensions * _data.scale;
+
+        sprites.push_back({ { _data.position, size, _data.rotation, _data.color, _region->TexRect, 0.f }, texture });
+    }
+    void CommandArena::RenderSprite(const render_data& _data, const std::shared_ptr<TextureLayer>& _layer) {
+
+        // Failed loads return an empty region, they were logged when loading
+        if (!_layer)
+            return;
+
+        uint16_t texture = Local(_layer->array);
+
+        glm::vec2 size = _layer->dimensions * _data.scale;
+
+        sprites.push_back({ { _data.position, size, _data.rotation, _data.color, _layer->TexRect, 0.f }, texture, _layer->layer });
+    }
+
+    // Half the string's extent, centers text on its position. Shared by the CPU and GPU text paths.
+    static glm::vec2 TextOffset(const std::string& _string, const glm::vec2& _scale, const std::shared_ptr<Font>& _font) {
+
+        // Font views (SDF sizes) reuse the glyphs of their base font, so the metrics are scaled
+        const float FontScale = _font->GetScale();
+
+        float px = 0;
+
+        glm::vec2 offset = { 0.f, 0.f };
+        float FirstBearing = 0.f;
+
+        for (size_t i = 0; i < _string.size();) {
+
+            bool first = (i == 0);
+            const Character& ch = _font->GetCharacter(DecodeUTF8(_string, i));
+
+            glm::vec2 size = ch.size * FontScale;
+            glm::vec2 bearing = ch.bearing * FontScale;
+            float advance = static_cast<float>(static_cast<int>(ch.advance.x) >> 6) * FontScale;
+
+            if (first)
+                FirstBearing = bearing.x;
+
+            float x = ((px + bearing.x) + (size.x / 2.f)) * _scale.x - offset.x;
+
+            if (i == _string.size())
+                offset.x = x + (size.x / 2.f) + (FirstBearing / 2.f) + 4;
+
+            offset.y = std::max(offset.y, size.y);
+
+            px += (advance - (bearing.x / 2.f)) * _scale.x;
+        }
+
+        return offset / 2.f;
+    }
+
+    // Text layout at the origin, cached by string, font and scale
+    const CommandArena::TextLayout& CommandArena::Layout(const std::string& _string, const glm::vec2& _scale, const std::shared_ptr<Font>& _font) {
+
+        unsigned int font = _font->GetTextureID();
+
+        // Font views (SDF sizes) reuse the glyphs of their base font, so the metrics are scaled
+        const float FontScale = _font->GetScale();
+
+        // FNV-1a over the string, font and scales
+        uint64_t key = 14695981039346656037ull;
+
+        auto hash = [&key](const void* _bytes, size_t _size) {
+            for (size_t i = 0; i < _size; i++)
+                key = (key ^ static_cast<const unsigned char*>(_bytes)[i]) * 1099511628211ull;
+        };
+
+        hash(_string.data(), _string.size());
+        hash(&font, sizeof(font));
+        hash(&FontScale, sizeof(FontScale));
+        hash(&_scale, sizeof(_scale));
+
+        auto found = layouts.find(key);
+
+        // Misses reuse an evicted node before allocating a new one
+        if (found == layouts.end()) {
+
+            if (spare.empty())
+                found = layouts.emplace(key, TextLayout()).first;
+            else {
+
+                auto node = std::move(spare.back());
+                spare.pop_back();
+
+                node.key() = key;
+                node.mapped().font = 0;
+
+                found = layouts.insert(std::move(node)).position;
+            }
+        }
+
+        TextLayout& layout = found->second;
+        layout.used = generation;
+
+        if (layout.font == font && layout.FontScale == FontScale && layout.scale == _scale && layout.string == _string && !layout.glyphs.empty())
+            return layout;
+
+        layout.string = _string;
+        layout.font = font;
+        layout.FontScale = FontScale;
+        layout.scale = _scale;
+        layout.glyphs.clear();
+
+        float px = 0;
+        float pz = 0;
+
+        glm::vec2 offset = TextOffset(_string, _scale, _font);
+
+        for (size_t i = 0; i < _string.size();) {
+
+            const Character& ch = _font->GetCharacter(DecodeUTF8(_string, i));
+
+            glm::vec2 size = ch.size * FontScale;
+            glm::vec2 bearing = ch.bearing * FontScale;
+            float advance = static_cast<float>(static_cast<int>(ch.advance.x) >> 6) * FontScale;
+
+            float xPos = ((px + bearing.x) + (size.x / 2.f)) * _scale.x - offset.x;
+
+            // Offsets:  glyph baseline bearing       glyph centering     string height
+            float yPos = (size.y - bearing.y) - (size.y / 2.f) + (offset.y - 1.f);
+
+            float t_Width = size.x * _scale.x;
+            float t_Height = size.y * _scale.y;
+
+            layout.glyphs.push_back({ CalculateVertexPositions({ xPos, yPos, pz += 0.00001f }, { t_Width, t_Height }), ch.TexCoords });
+
+            px += (advance - (bearing.x / 2.f)) * _scale.x;
+        }
+
+        return layout;
     }
 
     // Render text functions
-    void RenderText(const std::string& _string, const render_data& _data, const std::shared_ptr<Font>& _font) {
+    void CommandArena::RenderText(const std::string& _string, const render_data& _data, const std::shared_ptr<Font>& _font) {
+
+        uint16_t texture = Local(_font);
+
+        const TextLayout& layout = Layout(_string, _data.scale, _font);
+
+        float mode = (_font->GetMode() == FontMode::SDF) ? SAMPLE_MODE::SDF : SAMPLE_MODE::COVERAGE;
+
+        // The layout's y grows downwards (glyph rows are stored top down), it's flipped here rather than in
+        // the shader so text can share a batch with textures.
+        glm::vec3 origin = { _data.position.x * _data.scale.x, _data.position.y, _data.position.z };
+
+        for (const auto& glyph : layout.glyphs) {
+
+            QuadVertices vertices;
+
+            for (size_t v = 0; v < vertices.size(); v++)
+                vertices[v] = { origin.x + glyph.vertices[v].x, origin.y - glyph.vertices[v].y, origin.z + glyph.vertices[v].z };
+
+            quads.push_back({ vertices, glyph.texcoords, _data.color, texture, -1.f, mode });
+        }
+    }
+
+    // Uniform handles are looked up once, when the shader is first used
+    static const SceneShader& GetSceneShader(const std::string& _shader) {
+
+        auto found = sData.__scene_shaders.find(_shader);
+
+        if (found != sData.__scene_shaders.end())
+            return found->second;
+
+        const std::shared_ptr<Shader>& shader = sData.__shader_library->Get(_shader);
+
+        return sData.__scene_shaders.insert({ _shader, { shader, shader->GetUniform("u_SDF") } }).first->second;
+    }
+
+    // One draw per static text, white in slot 0 and the text's font in slot 1. Drawn with the "uber" shader, whatever
+    // the scene's, since only it samples both font modes.
+    static void DrawStaticText() {
+
+        if (sData.__static_text.empty())
+            return;
+
+        if (!sData.__static_text_shader.shader)
+            sData.__static_text_shader = GetSceneShader("uber");
+
+        // Camera comes from the scene uniform block
+        sData.__static_text_shader.shader->Bind();
+        sData.__white->Bind(0);
+
+        for (StaticText* text : sData.__static_text) {
+
+            text->GetFont()->Sync();
+            text->GetFont()->Bind(1);
+
+            text->GetVertexArray()->Bind();
+            Manager::DrawIndexed(text->GetVertexArray(), text->GetIndexCount());
+        }
+
+        sData.__quad_vtx_array->Bind();
+        sData.__static_text.clear();
+
+        if (sData.__scene_shader)
+            sData.__scene_shader->Bind();
+    }
+
+    // One draw per glyph run, the font's glyph table at storage binding 0 and its atlas in unit 1. Only called from
+    // EndScene, so GPU text always lands after the scene's quads. Runs are copied into the ring a region at a time,
+    // a run crossing a region boundary is split into two draws.
+    static void FlushGlyphs() {
+
+        if (sData.__glyph_instances.empty())
+            return;
+
+        Statistics::CountFlush();
+        Statistics::CountBytesUploaded(static_cast<uint64_t>(sData.__glyph_instances.size()) * sizeof(Graphics::GlyphInstance));
+
+        if (!sData.__text_gpu_shader.shader)
+            sData.__text_gpu_shader = GetSceneShader("text_gpu");
+
+        const SceneShader& text = sData.__text_gpu_shader;
+
+        // Camera comes from the scene uniform block
+        text.shader->Bind();
+
+        sData.__glyph_vtx_array->Bind();
+
+        uint32_t used = 0;      // Instances written to the current region
+
+        for (const GlyphRun& run : sData.__glyph_runs) {
+
+            // Creates the glyph table on first use, then uploads glyphs added since the last sync
+            glad_glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, run.font->GetGlyphBuffer());
+            run.font->Sync();
+            run.font->Bind(1);
+
+            text.shader->SetBool(text.SDF, run.font->GetMode() == FontMode::SDF);
+
+            uint32_t first = run.first;
+            uint32_t remaining = run.count;
+
+            while (remaining > 0) {
+
+                if (used == sData.MaxGlyphInstances) {
+
+                    sData.__glyph_inst_buffer->FenceRegion();
+                    sData.__glyph_buf_base = static_cast<Graphics::GlyphInstance*>(sData.__glyph_inst_buffer->MapRegion());
+                    used = 0;
+                }
+
+                uint32_t count = std::min(remaining, sData.MaxGlyphInstances - used);
+                int __base_instance = static_cast<int>(sData.__glyph_inst_buffer->GetRegion() * sData.MaxGlyphInstances + used);
 
-        sData.__shader_library->GetMap().find("text")->second->SetBool("u_Debug", false);
+                std::memcpy(sData.__glyph_buf_base + used, sData.__glyph_instances.data() + first, count * sizeof(Graphics::GlyphInstance));
+                Manager::DrawIndexedInstanced(sData.__glyph_vtx_array, 6, count, __base_instance);
 
-        if (sData.__texslot > sData.__max_texture_units - 1 || sData.__quad_index_count > sData.MaxIndices)
-            FlushScene();
+                used += count;
+                first += count;
+                remaining -= count;
+            }
+        }
+
+        sData.__quad_vtx_array->Bind();
+
+        sData.__glyph_inst_buffer->FenceRegion();
+        sData.__glyph_buf_base = static_cast<Graphics::GlyphInstance*>(sData.__glyph_inst_buffer->MapRegion());
+        sData.__glyph_instances.clear();
+        sData.__glyph_runs.clear();
+
+        if (sData.__scene_shader)
+            sData.__scene_shader->Bind();
+    }
 
-        int texslot = 0;
+    // Binds the camera's slot of the scene uniform block, rewriting it only if the camera changed
+    static void BindCamera(const std::unique_ptr<OrthoCam>& _camera) {
 
-        for (int i = 1; i < sData.__texslot; i++) {
-            if (sData.__bound_texture_array[i]->GetTextureID() == _font->GetTextureID()) {
-                texslot = i;
-                break;
+        const OrthoCam* camera = _camera.get();
+
+        uint32_t slot = 0;
+        bool found = false;
+
+        for (uint32_t i = 0; i < sData.MaxCameras && !found; i++) {
+            if (sData.__camera_slots[i] == camera) {
+                slot = i;
+                found = true;
             }
         }
-        if (texslot == 0) {
-            sData.__bound_texture_array[sData.__texslot] = _font;
-            texslot = sData.__texslot++;
+
+        SceneBlock block = { camera->GetViewProjectionMatrix(), glm::mat4(1.f), glm::vec4(1.f), sData.WindowSize, glm::vec2(0.f) };
+
+        if (!found) {
+            slot = sData.__camera_next++ % sData.MaxCameras;
+            sData.__camera_slots[slot] = camera;
         }
 
-        float px = 0;
-        float pz = _data.position.z;
+        if (!found || std::memcmp(&block, &sData.__camera_blocks[slot], sizeof(SceneBlock)) != 0) {
 
-        // Calculate string offset
-        glm::vec2 offset = { 0.f, 0.f };
-        for (std::string::const_iterator i = _string.begin(); i != _string.end(); ++i) {
+            glad_glNamedBufferSubData(sData.__scene_ubo, static_cast<GLintptr>(slot) * sData.__scene_ubo_stride, sizeof(SceneBlock), &block);
 
-            Character ch = _font->GetCharacters().find(*i)->second;
+            sData.__camera_blocks[slot] = block;
+            Statistics::CountBytesUploaded(sizeof(SceneBlock));
+        }
+
+        glad_glBindBufferRange(GL_UNIFORM_BUFFER, 0, sData.__scene_ubo, static_cast<GLintptr>(slot) * sData.__scene_ubo_stride, sizeof(SceneBlock));
+    }
+
+    // Render commands
+    void StartScene(const std::unique_ptr<OrthoCam>& camera, const std::string& _shader) {
 
-            float x = ((px + ch.bearing.x) + (ch.size.x / 2.f)) * _data.scale.x - offset.x;
+        Statistics::BeginScene(_shader);
+        Profiler::BeginScene(_shader);
 
-            if (i == _string.end() - 1)
-                offset.x = x + (ch.size.x / 2.f) + (_font->GetCharacters().find(_string[0])->second.bearing.x / 2.f) + 4;
+        const SceneShader& scene = GetSceneShader(_shader);
+
+        sData.__scene_shader = scene.shader;
+
+        BindCamera(camera);
+        scene.shader->Bind();
+    }
+    void FlushScene() {
+
+        if (sData.__quad_index_count <= 0 && sData.__sprite_count <= 0)
+            return;
 
-            offset.y = std::max(offset.y, ch.size.y);
+        Statistics::CountFlush();
+        Statistics::CountBytesUploaded(static_cast<uint64_t>(sData.__quad_index_count / 6) * 4 * sizeof(Graphics::Vertex) +
+                                       static_cast<uint64_t>(sData.__sprite_count) * sizeof(Graphics::SpriteInstance));
 
-            px += ((static_cast<int>(ch.advance.x) >> 6) - (ch.bearing.x / 2.f)) * _data.scale.x;
+        for (int i = 0; i < sData.__texslot; i++)
+            sData.__bound_texture_array[i]->Bind(i);
+
+        if (sData.__quad_index_count > 0) {
+
+            // Vertices are already in GPU visible memory, draw straight from the current region
+            int __base_vertex = static_cast<int>(sData.__quad_vtx_buffer->GetRegion() * sData.MaxVertices);
+
+            Manager::DrawIndexed(sData.__quad_vtx_array, sData.__quad_index_count, __base_vertex);
+
+            // Fence the region the GPU is now reading from, and move on to the next one
+            sData.__quad_vtx_buffer->FenceRegion();
+            sData.__quad_vtx_buf_base = static_cast<Graphics::Vertex*>(sData.__quad_vtx_buffer->MapRegion());
         }
-        offset /= 2.f;
 
-        px = _data.position.x;
+        if (sData.__sprite_count > 0) {
 
-        for (std::string::const_iterator i = _string.begin(); i != _string.end(); ++i) {
+            int __base_instance = static_cast<int>(sData.__sprite_inst_buffer->GetRegion() * sData.MaxSprites);
 
-            if (sData.__quad_index_count > sData.MaxIndices)
-                FlushScene();
+            sData.__sprite_vtx_array->Bind();
+            Manager::DrawIndexedInstanced(sData.__sprite_vtx_array, 6, sData.__sprite_count, __base_instance);
+            sData.__quad_vtx_array->Bind();
+
+            sData.__sprite_inst_buffer->FenceRegion();
+            sData.__sprite_buf_base = static_cast<Graphics::SpriteInstance*>(sData.__sprite_inst_buffer->MapRegion());
+        }
+
+        for (int i = 1; i < sData.__texslot; i++)
+            sData.__bound_texture_array[i] = sData.__white;
+        for (auto& slot : sData.__scene_texture_slots)
+            slot = 0;
+
+        sData.__texslot = 1;
+        sData.__scene_array = 0;
+        sData.__quad_index_count = 0;
+        sData.__quad_vtx_buf_ptr = sData.__quad_vtx_buf_base;
+        sData.__sprite_count = 0;
+        sData.__sprite_buf_ptr = sData.__sprite_buf_base;
+    }
+    void EndScene() {
+
+        Submit(sData.__arena);
 
-            Character ch = _font->GetCharacters().find(*i)->second;
+        SubmitQueue();
+        FlushScene();
+
+        DrawStaticText();
+        FlushGlyphs();
 
-            float xPos = ((px + ch.bearing.x) + (ch.size.x / 2.f)) * _data.scale.x - offset.x;
+        sData.__arena.clear();
+        ResetSceneTextures();
 
-            // yPos offset calculations are inverted, because font is inverted, then corrected in the shader.
-            // Offsets:  inverted y axis position    glyph baseline bearing       glyph centering     string height
-            float yPos = (_data.position.y * -1.f) + (ch.size.y - ch.bearing.y) - (ch.size.y / 2.f) + (offset.y - 1.f);
+        Statistics::EndScene();
+        Profiler::EndScene();
+    }
 
-            float t_Width = static_cast<float>(ch.size.x) * _data.scale.x;
-            float t_Height = static_cast<float>(ch.size.y) * _data.scale.y;
+    void Submit(const CommandArena& _arena) {
 
-            AddQuad(CalculateVertexPositions({ xPos, yPos, pz += 0.00001 }, { t_Width, t_Height }), _data.color, ch.TexCoords.data(), static_cast<float>(texslot));
+        if (sData.__arenas.size() >= sData.MaxArenas) {
+            ASWL::Logger::logger("R0001", "Error: Too many command arenas submitted to one scene.");
+            return;
+        }
 
-            px += ((static_cast<int>(ch.advance.x) >> 6) - (ch.bearing.x / 2.f)) * _data.scale.x;
+        if (_arena.GetQuads().size() > MaxArenaCommands || _arena.GetSprites().size() > MaxArenaCommands) {
+            ASWL::Logger::logger("R0002", "Error: Command arena holds more commands than a sort entry can index.");
+            return;
+        }
+
+        size_t arena = sData.__arenas.size();
+        sData.__arenas.push_back(&_arena);
+
+        if (sData.__arena_textures.size() <= arena)
+            sData.__arena_textures.resize(arena + 1);
+
+        // Textures are registered once per arena, commands only carry the local index
+        std::vector<uint16_t>& textures = sData.__arena_textures[arena];
+        textures.clear();
+        textures.push_back(0);
+
+        for (size_t i = 1; i < _arena.GetTextures().size(); i++) {
+
+            // Glyphs recorded since the last scene are uploaded before the first draw
+            _arena.GetTextures()[i]->Sync();
+            textures.push_back(RegisterTexture(_arena.GetTextures()[i]));
+        }
+    }
+
+    // Draw static quad functions
+    void DrawQuad(const render_data& _data) {
+        sData.__arena.DrawQuad(_data);
+    }
+
+    // Render texture functions
+    void RenderTexture(const render_data& _data, const std::shared_ptr<Texture>& _texture) {
+        sData.__arena.RenderTexture(_data, _texture);
+    }
+    void RenderTexture(const render_data& _data, const std::shared_ptr<AtlasRegion>& _region) {
+        sData.__arena.RenderTexture(_data, _region);
+    }
+    void RenderTexture(const render_data& _data, const std::shared_ptr<TextureLayer>& _layer) {
+        sData.__arena.RenderTexture(_data, _layer);
+    }
+
+    // Render sprite functions
+    void RenderSprite(const render_data& _data, const std::shared_ptr<Texture>& _texture) {
+        sData.__arena.RenderSprite(_data, _texture);
+    }
+    void RenderSprite(const render_data& _data, const std::shared_ptr<AtlasRegion>& _region) {
+        sData.__arena.RenderSprite(_data, _region);
+    }
+    void RenderSprite(const render_data& _data, const std::shared_ptr<TextureLayer>& _layer) {
+        sData.__arena.RenderSprite(_data, _layer);
+    }
+
+    // Render text functions
+    void RenderText(const std::string& _string, const render_data& _data, const std::shared_ptr<Font>& _font) {
+        sData.__arena.RenderText(_string, _data, _font);
+    }
+
+    void RenderStaticText(StaticText& _text) {
+
+        if (_text.IsDirty()) {
+            _text.Build();
+            sData.__quad_vtx_array->Bind();
+        }
+
+        if (_text.GetIndexCount() > 0)
+            sData.__static_text.push_back(&_text);
+    }
+
+    void RenderTextGPU(const std::string& _string, const render_data& _data, const std::shared_ptr<Font>& _font) {
+
+        if (_string.empty())
+            return;
+
+        // Font views (SDF sizes) reuse the glyphs of their base font, so the metrics are scaled
+        const float FontScale = _font->GetScale();
+
+        // Same pen, centering and y flip as CommandArena::RenderText, the pen is placed so the shader's quad lands
+        // where RenderText would put the glyph
+        const glm::vec2 offset = TextOffset(_string, _data.scale, _font);
+        const glm::vec3 origin = { _data.position.x * _data.scale.x, _data.position.y, _data.position.z };
+
+        uint32_t color = glm::packUnorm4x8(_data.color);
+        uint32_t PackedScale = glm::packHalf2x16(_data.scale * FontScale);
+
+        // Consecutive strings in the same font (or a view of it) share a draw
+        if (sData.__glyph_runs.empty() || sData.__glyph_runs.back().font->GetTextureID() != _font->GetTextureID())
+            sData.__glyph_runs.push_back({ _font, static_cast<uint32_t>(sData.__glyph_instances.size()), 0 });
+
+        float px = 0.f;
+        float pz = 0.f;
+
+        for (size_t i = 0; i < _string.size();) {
+
+            uint32_t codepoint = DecodeUTF8(_string, i);
+
+            const Character& ch = _font->GetCharacter(codepoint);
+            uint16_t glyph = _font->GetGlyphIndex(codepoint);
+
+            glm::vec2 size = ch.size * FontScale;
+            glm::vec2 bearing = ch.bearing * FontScale;
+            float advance = static_cast<float>(static_cast<int>(ch.advance.x) >> 6) * FontScale;
+
+            float xPos = ((px + bearing.x) + (size.x / 2.f)) * _data.scale.x - offset.x;
+            float yPos = (size.y - bearing.y) - (size.y / 2.f) + (offset.y - 1.f);
+
+            // Bottom left of RenderText's quad, less the bearing the shader adds back
+            glm::vec2 BottomLeft = { origin.x + xPos - (size.x * _data.scale.x / 2.f), origin.y - yPos - (size.y * _data.scale.y / 2.f) };
+            glm::vec2 pen = BottomLeft - glm::vec2(bearing.x, bearing.y - size.y) * _data.scale;
+
+            sData.__glyph_instances.push_back({ { pen.x, pen.y, origin.z + (pz += 0.00001f) }, glyph, color, PackedScale });
+            sData.__glyph_runs.back().count++;
+
+            px += (advance - (bearing.x / 2.f)) * _data.scale.x;
         }
     }
 
     // Render Loading Indicator
     void LoadingDots(const int _count, const float _spacing, const float _radius, const render_data& _data, const std::chrono::steady_clock::duration& _clock) {
 
-        AddQuad(CalculateVertexPositions(_data.position, _data.scale), _data.color, sData.DefaultTexCoords);
+        // Queued like any other quad, the uniforms below apply to the whole scene
+        sData.__arena.DrawQuad(_data);
 
-        std::shared_ptr<Shader> shader = sData.__shader_library->GetMap().find("dots")->second;
+        const std::shared_ptr<Shader>& shader = sData.__shader_library->Get("dots");
 
         float runtime = std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(_clock).count() / 1000.f;
 
-        shader->SetFloat2("u_Resolution", sData.WindowSize);
         shader->SetInt("u_CircleCount", _count);
         shader->SetFloat("u_Spacing", _spacing);
         shader->SetFloat("u_Radius", _radius);
@@ -367,11 +1245,11 @@ namespace Fleet::Core::Graphics::Renderer {
     // Render Grid (debug_mode)
     void RenderGrid(const glm::vec3& _CameraPosition, const float _CellSize, const float _zoom) {
 
-        AddQuad(CalculateVertexPositions({ 0, 0, 1.f }, sData.WindowSize), glm::vec4(1.f), sData.DefaultTexCoords);
-        std::shared_ptr<Shader> shader = sData.__shader_library->GetMap().find("grid")->second;
+        sData.__arena.DrawQuad({ glm::vec3(0.f, 0.f, 1.f), sData.WindowSize, glm::vec4(1.f) });
+
+        const std::shared_ptr<Shader>& shader = sData.__shader_library->Get("grid");
 
         shader->SetFloat("u_CellSize", _CellSize);
-        shader->SetFloat2("u_Resolution", sData.WindowSize);
         shader->SetFloat3("u_CameraPosition", _CameraPosition);
     }
 }
@@ -27,18 +27,28 @@
 #define FLEET_ENGINE_GRAPHICS_RENDERER
 
 // Include standard library
+#include <array>
 #include <string>
 #include <chrono>
 #include <memory>
+#include <vector>
+#include <unordered_map>
 
 // Include dependencies
 #include <GLM/glm/glm.hpp>
 
 // Include Fleet libraries
 #include "font.hpp"
+#include "atlas.hpp"
 #include "texture.hpp"
+#include "texturearray.hpp"
+#include "vertex.hpp"
 #include "camera/orthocam.hpp"
 
+namespace Fleet::Core::Graphics {
+    class StaticText;
+}
+
 namespace Fleet::Core::Graphics::Renderer {
 
     namespace RENDER_LAYER {
@@ -50,6 +60,19 @@ namespace Fleet::Core::Graphics::Renderer {
         constexpr float LAYER4 = 0.4f;
     }
 
+    // Render queue limits. Sort entries pack the arena into 8 bits and its command into 24 bits, the renderer's
+    // own arena takes one of the MaxArenas slots.
+    constexpr uint32_t MaxArenas = 256;
+    constexpr uint32_t MaxArenaCommands = 1u << 24;         // Quads and sprites, each
+
+    // Per vertex sample mode, lets the "uber" shader draw textures and text in the same batch
+    namespace SAMPLE_MODE {
+
+        constexpr float RGBA = 0.f;             // Textures
+        constexpr float COVERAGE = 1.f;         // Bitmap glyphs, alpha in the red channel
+        constexpr float SDF = 2.f;              // Signed distance field glyphs
+    }
+
     struct render_data {
         glm::vec3 position;
         glm::vec2 scale;
@@ -57,8 +80,91 @@ namespace Fleet::Core::Graphics::Renderer {
         float rotation = 0;
     };
 
-    std::vector<glm::vec3> CalculateVertexPositions(const glm::vec3& _position, const glm::vec2& _size);
-    std::vector<glm::vec3> RotateVertices(const std::vector<glm::vec3>& _vertices, const glm::vec3& _position, const float _rotation);
+    // Fixed size quad data, submitting a quad never touches the heap
+    using QuadVertices = std::array<glm::vec3, 4>;
+    using QuadTexCoords = std::array<glm::vec2, 4>;
+
+    QuadVertices CalculateVertexPositions(const glm::vec3& _position, const glm::vec2& _size);
+    QuadVertices RotateVertices(const QuadVertices& _vertices, const glm::vec3& _position, const float _rotation);
+
+    // Deferred submissions. Texture indices are local to the arena that recorded them, 0 -> white.
+    struct QuadCommand {
+        QuadVertices vertices;
+        QuadTexCoords texcoords;
+        glm::vec4 color;
+        uint16_t texture;
+        float layer = -1.f;         // Texture array layer, -1 -> slot bound texture
+        float mode = SAMPLE_MODE::RGBA;
+    };
+    struct SpriteCommand {
+        SpriteInstance instance;
+        uint16_t texture;
+        float layer = -1.f;         // Texture array layer, -1 -> slot bound texture
+    };
+
+    class CommandArena {
+
+        /// Records quads, sprites and text without touching GL or renderer state, so any thread can fill its own arena.
+        /// The GL thread hands arenas to Submit between StartScene and EndScene. An arena must not be recorded into
+        /// between Submit and EndScene, and keeps its capacity across clear(). Text layouts are cached per arena.
+
+    public:
+
+        explicit CommandArena(size_t _reserve = 0);
+
+        void DrawQuad(const render_data& _data);
+
+        void RenderTexture(const render_data& _data, const std::shared_ptr<Texture>& _texture);
+        void RenderTexture(const render_data& _data, const std::shared_ptr<AtlasRegion>& _region);
+        void RenderTexture(const render_data& _data, const std::shared_ptr<TextureLayer>& _layer);
+
+        void RenderSprite(const render_data& _data, const std::shared_ptr<Texture>& _texture);
+        void RenderSprite(const render_data& _data, const std::shared_ptr<AtlasRegion>& _region);
+        void RenderSprite(const render_data& _data, const std::shared_ptr<TextureLayer>& _layer);
+
+        void RenderText(const std::string& _string, const render_data& _data, const std::shared_ptr<Font>& _font);
+
+        void clear();
+
+        const std::vector<QuadCommand>& GetQuads() const;
+        const std::vector<SpriteCommand>& GetSprites() const;
+        const std::vector<std::shared_ptr<Texture>>& GetTextures() const;       // Index 0 is the white texture (nullptr)
+
+    private:
+
+        struct GlyphQuad {
+            QuadVertices vertices;
+            QuadTexCoords texcoords;
+        };
+        struct TextLayout {
+            std::string string;                 // Confirms hash hits
+            unsigned int font;                  // Font texture ID
+            float FontScale;
+            glm::vec2 scale;
+
+            std::vector<GlyphQuad> glyphs;      // Laid out at the origin
+            uint64_t used;                      // Generation of the last use
+        };
+
+        uint16_t Local(const std::shared_ptr<Texture>& _texture);
+
+        const TextLayout& Layout(const std::string& _string, const glm::vec2& _scale, const std::shared_ptr<Font>& _font);
+
+        std::vector<QuadCommand> quads;
+        std::vector<SpriteCommand> sprites;
+        std::vector<std::shared_ptr<Texture>> textures;
+
+        uint16_t last = 0;
+
+        // Text layout cache, layouts unused for LayoutLifetime clears are evicted. Evicted nodes are kept and
+        // reused with their string and glyph capacity, so once the cache is warm (2 x LayoutLifetime clears) misses
+        // don't allocate either.
+        static constexpr uint64_t LayoutLifetime = 64;
+
+        std::unordered_map<uint64_t, TextLayout> layouts;
+        std::vector<std::unordered_map<uint64_t, TextLayout>::node_type> spare;
+        uint64_t generation = 0;
+    };
 
     // Renderer Control
     void init(const glm::vec2& _WindowSize, int _MaxTextureUnits = 16);
@@ -66,29 +172,62 @@ namespace Fleet::Core::Graphics::Renderer {
 
     void SetWindowSize(const glm::vec2& _WindowSize);
 
-    // Add to batch
-    void AddQuad(const std::vector<glm::vec3>& _vertices, const glm::vec4& _color, glm::vec2 _TexCoords[4], const float _texslot = 0);
+    // Shared quad index buffer (0 1 2 2 3 0 per quad), for objects that own their vertices
+    const std::shared_ptr<IndexBuffer>& GetQuadIndexBuffer();
+    const uint32_t GetMaxQuads();
 
-    // Render commands+
+    // Add to batch
+    void AddQuad(const QuadVertices& _vertices, const glm::vec4& _color, const QuadTexCoords& _TexCoords, const float _texslot = 0, const float _mode = SAMPLE_MODE::RGBA);
+    void AddSprite(const glm::vec3& _position, const glm::vec2& _size, const float _rotation, const glm::vec4& _color, const glm::vec4& _TexRect, const float _texslot = 0);
+
+    // Render commands. Draw, texture, sprite and text submissions are queued between StartScene and EndScene,
+    // then sorted by layer, texture and depth so they are emitted in as few draw calls as possible.
+    // Scenes started with the "uber" shader draw textures and text of either font mode in the same batch.
+    //
+    // Draw order: a higher RENDER_LAYER always draws over a lower one. Within a layer, commands are grouped by
+    // texture first and sorted back to front by depth inside each group, commands with equal keys keep their
+    // submission order. Overlapping translucent quads with different textures on the same layer are therefore
+    // drawn in texture order, give them their own layers if their order matters. All quads of a scene are drawn
+    // before its sprites, then static text, then GPU text.
     void StartScene(const std::unique_ptr<OrthoCam>& camera, const std::string& _shader = "basic");
     void FlushScene();
     void EndScene();
 
+    // Queue a recorded arena into the current scene (GL thread only). Up to MaxArenas - 1 arenas per scene, arenas
+    // holding more than MaxArenaCommands quads or sprites are rejected. The arena is read in EndScene, so it must
+    // outlive the scene, temporaries can't be submitted.
+    void Submit(const CommandArena& _arena);
+    void Submit(CommandArena&&) = delete;
+
     // Draw Static Quad
     void DrawQuad(const render_data& _data);
 
     // Render Texture
     void RenderTexture(const render_data& _data, const std::shared_ptr<Texture>& _texture);
+    void RenderTexture(const render_data& _data, const std::shared_ptr<AtlasRegion>& _region);
+    void RenderTexture(const render_data& _data, const std::shared_ptr<TextureLayer>& _layer);      // Scene must be started with the "array" shader
+
+    // Render Sprite (instanced, scene must be started with the "sprite" shader)
+    void RenderSprite(const render_data& _data, const std::shared_ptr<Texture>& _texture);
+    void RenderSprite(const render_data& _data, const std::shared_ptr<AtlasRegion>& _region);
+    void RenderSprite(const render_data& _data, const std::shared_ptr<TextureLayer>& _layer);       // Scene must be started with the "sprite_array" shader
 
     // Render Text
     void RenderText(const std::string& _string, const render_data& _data, const std::shared_ptr<Font>& _font);
+    void RenderStaticText(StaticText& _text);       // Rebuilt here if changed, drawn with the "uber" shader after the scene's queued commands
+
+    // Render Text on the GPU. Only a glyph index, pen and color per glyph are uploaded, the "text_gpu" shader builds
+    // the quads from the font's glyph table. Laid out and centered exactly like RenderText, drawn after static text.
+    // GL thread only.
+    void RenderTextGPU(const std::string& _string, const render_data& _data, const std::shared_ptr<Font>& _font);
 
     // TODO: RenderObject
 
-    // Render Loading Indicator
+    // Render Loading Indicator (scene must be started with the "dots" shader). The quad is queued like any other
+    // command, the uniforms are set right away so there is one indicator per scene.
     void LoadingDots(const int _count, const float _spacing, const float _radius, const render_data& _data, const std::chrono::steady_clock::duration& _clock);
 
-    // Render Grid (debug_mode)
+    // Render Grid (debug_mode, scene must be started with the "grid" shader, one grid per scene)
     void RenderGrid(const glm::vec3& _CameraPosition, const float _CellSize, const float _zoom = 1.f);
 }
 
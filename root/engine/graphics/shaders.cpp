@@ -24,10 +24,14 @@
 #include "shaders.hpp"
 
 // Include standard library
+#include <set>
 #include <array>
+#include <cstdio>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <sstream>
+#include <filesystem>
 #include <unordered_map>
 
 // Include dependencies
@@ -35,8 +39,82 @@
 #include <ASWL/utilities.hpp>
 #include <ASWL/logger.hpp>
 
+// Include Fleet libraries
+#include "manager.hpp"
+#include "../cache.hpp"
+
 namespace Fleet::Core::Graphics {
 
+    // Program binary cache file: header followed by the driver's binary
+    struct ProgramCacheHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t format;
+        uint32_t length;
+    };
+
+    static constexpr char ProgramCacheMagic[4] = { 'F', 'P', 'R', 'G' };
+    static constexpr uint32_t ProgramCacheVersion = 1;
+
+    // Binaries are only valid for the driver that produced them
+    static const std::string& DriverString() {
+
+        static const std::string driver = [] {
+            std::string __driver;
+            for (GLenum name : { GL_VERSION, GL_RENDERER, GL_VENDOR }) {
+                const GLubyte* value = glad_glGetString(name);
+                __driver += value ? reinterpret_cast<const char*>(value) : "";
+                __driver += '\n';
+            }
+            return __driver;
+        }();
+
+        return driver;
+    }
+
+    // Replaces #include "file" lines by the file, recursively
+    static void ExpandIncludes(const std::filesystem::path& _path, std::set<std::filesystem::path>& _included, std::string& _out) {
+
+        std::string source = ASWL::Utilities::ReadFile(_path.string(), std::ios::binary);
+        std::istringstream iss(source);
+
+        for (std::string __line; std::getline(iss, __line); ) {
+
+            size_t start = __line.find_first_not_of(" \t");
+
+            if (start == std::string::npos || __line.compare(start, 8, "#include") != 0) {
+
+                _out += __line;
+                _out += '\n';
+
+                continue;
+            }
+
+            size_t open = __line.find('"', start + 8);
+            size_t close = (open == std::string::npos) ? std::string::npos : __line.find('"', open + 1);
+
+            if (close == std::string::npos) {
+
+                ASWL::Logger::logger("S0004", "Error: Malformed #include in [", _path.string(), "].");
+                continue;
+            }
+
+            std::filesystem::path file = (_path.parent_path() / __line.substr(open + 1, close - open - 1)).lexically_normal();
+
+            // Every file is included once, which also breaks include cycles
+            if (!_included.insert(file).second)
+                continue;
+
+            if (!std::filesystem::exists(file)) {
+
+                ASWL::Logger::logger("S0004", "Error: Could not find included file [", file.string(), "].");
+                continue;
+            }
+
+            ExpandIncludes(file, _included, _out);
+        }
+    }
+
     int ShaderDataTypeSize(ShaderDataType type) {
 
         switch (type) {
@@ -107,17 +185,47 @@ namespace Fleet::Core::Graphics {
 
     void Shader::init(const std::string& vtxPath, const std::string& frgPath) {
 
-        std::string vtxSource = ASWL::Utilities::ReadFile(vtxPath, std::ios::binary);  // Read Vertex Shader
-        std::string frgSource = ASWL::Utilities::ReadFile(frgPath, std::ios::binary);  // Read Fragment Shader
+        Compile(vtxPath, frgPath);
+        Finish();
+    }
 
-        // --- Shader processing
+    void Shader::init(const std::string& _name, const std::string& vtxPath, const std::string& frgPath) {
+
+        init(vtxPath, frgPath);
+        name = _name;
+    }
+
+    void Shader::Compile(const std::string& vtxPath, const std::string& frgPath, const ShaderDefines& _defines) {
+
+        std::string vtxSource = Preprocess(vtxPath, _defines);  // Read Vertex Shader
+        std::string frgSource = Preprocess(frgPath, _defines);  // Read Fragment Shader
+
+        pending = false;
+        stages = {};
+
+        // Reuse the linked program from the last launch if neither the sources (includes & defines expanded) nor
+        // the driver changed
+        uint64_t key = Cache::Hash(vtxSource);
+        key = Cache::Hash("\n--\n", key);
+        key = Cache::Hash(frgSource, key);
+        key = Cache::Hash(DriverString(), key);
+
+        char file[32];
+        std::snprintf(file, sizeof(file), "%016llx.program", static_cast<unsigned long long>(key));
+        CachePath = Cache::Path("shaders", file);
+
+        if (LoadBinary(CachePath)) {
+            Reflect();
+            return;
+        }
+
+        // --- Shader processing, statuses are only queried in Finish so the driver doesn't have to wait
         std::unordered_map<GLenum, std::string> sources;
         sources[GL_VERTEX_SHADER] = vtxSource;
         sources[GL_FRAGMENT_SHADER] = frgSource;
 
         unsigned int program = glad_glCreateProgram();
 
-        std::array<unsigned int, 2> ids = {};
         int idIndex = 0;
 
         for (auto& source : sources) {
@@ -131,67 +239,148 @@ namespace Fleet::Core::Graphics {
             glad_glShaderSource(shader, 1, &srcCStr, 0);
             glad_glCompileShader(shader);
 
+            glad_glAttachShader(program, shader);
+            stages[idIndex++] = shader;
+        }
+
+        RendererID = program;
+
+        glad_glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        glad_glLinkProgram(program);
+
+        pending = true;
+    }
+
+    void Shader::Compile(const std::string& _name, const std::string& vtxPath, const std::string& frgPath, const ShaderDefines& _defines) {
+
+        Compile(vtxPath, frgPath, _defines);
+        name = _name;
+    }
+
+    bool Shader::Finish() {
+
+        if (!pending)
+            return RendererID != 0;
+
+        pending = false;
+
+        auto release = [this] {
+
+            Manager::ForgetProgram(RendererID);
+            glad_glDeleteProgram(RendererID);
+
+            for (auto id : stages)
+                glad_glDeleteShader(id);
+
+            RendererID = 0;
+            stages = {};
+        };
+
+        for (auto id : stages) {
+
             GLint isCompiled = 0;
-            glad_glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
+            glad_glGetShaderiv(id, GL_COMPILE_STATUS, &isCompiled);
 
             // If shader compilation fails, log the error
             if (isCompiled == GL_FALSE) {
 
                 GLint logLength = 0;
-                glad_glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &logLength);
-                
-                std::vector<GLchar> log(logLength);
-                glad_glGetShaderInfoLog(shader, logLength, &logLength, &log[0]);
+                glad_glGetShaderiv(id, GL_INFO_LOG_LENGTH, &logLength);
+
+                std::vector<GLchar> log(logLength + 1);
+                glad_glGetShaderInfoLog(id, logLength, &logLength, &log[0]);
 
-                glad_glDeleteShader(shader);
+                release();
 
                 // Log
                 ASWL::Logger::logger("S0002", "Error: Could not compile shader -> ", log.data());
 
-                return;
+                return false;
             }
-
-            glad_glAttachShader(program, shader);
-            ids[idIndex++] = shader;
         }
 
-        RendererID = program;
-
-        glad_glLinkProgram(program);
         GLint isLinked = 0;
 
-        glad_glGetProgramiv(program, GL_LINK_STATUS, (int*)&isLinked);
+        glad_glGetProgramiv(RendererID, GL_LINK_STATUS, (int*)&isLinked);
         if (isLinked == GL_FALSE) {
 
             GLint logLength = 0;
-            glad_glGetShaderiv(program, GL_INFO_LOG_LENGTH, &logLength);
+            glad_glGetProgramiv(RendererID, GL_INFO_LOG_LENGTH, &logLength);
 
-            std::vector<GLchar> log(logLength);
-            glad_glGetShaderInfoLog(program, logLength, &logLength, &log[0]);
+            std::vector<GLchar> log(logLength + 1);
+            glad_glGetProgramInfoLog(RendererID, logLength, &logLength, &log[0]);
 
-            glad_glDeleteProgram(program);
-
-            for (auto id : ids)
-                glad_glDeleteShader(id);
+            release();
 
             // Log
             ASWL::Logger::logger("S0002", "Error: Failed to link shaders -> ", log.data());
 
-            return;
+            return false;
         }
 
-        for (auto id : ids) {
-            glad_glDetachShader(program, id);
+        for (auto id : stages) {
+            glad_glDetachShader(RendererID, id);
             glad_glDeleteShader(id);
         }
 
+        stages = {};
+
+        SaveBinary(CachePath);
+        Reflect();
+
         // --- End shader processing
+
+        return true;
     }
 
-    void Shader::init(const std::string& _name, const std::string& vtxPath, const std::string& frgPath) {
+    const bool Shader::IsReady() const {
 
-        init(vtxPath, frgPath);
-        name = _name;
+        // Without the extension there's nothing running in the background, Finish compiles in place
+        if (!pending || !GLAD_GL_KHR_parallel_shader_compile)
+            return true;
+
+        GLint completed = GL_FALSE;
+        glad_glGetProgramiv(RendererID, GL_COMPLETION_STATUS_KHR, &completed);
+
+        return completed == GL_TRUE;
+    }
+
+    std::string Shader::Preprocess(const std::string& _path, const ShaderDefines& _defines) {
+
+        std::filesystem::path path = std::filesystem::path(_path).lexically_normal();
+        std::set<std::filesystem::path> included = { path };
+
+        std::string source;
+        ExpandIncludes(path, included, source);
+
+        if (_defines.empty())
+            return source;
+
+        std::string __defines;
+
+        for (const auto& [__name, value] : _defines) {
+
+            __defines += "#define " + __name;
+
+            if (!value.empty())
+                __defines += " " + value;
+
+            __defines += '\n';
+        }
+
+        // #version has to stay the first directive
+        size_t version = source.find("#version");
+        size_t insert = 0;
+
+        if (version != std::string::npos) {
+
+            insert = source.find('\n', version);
+            insert = (insert == std::string::npos) ? source.size() : insert + 1;
+        }
+
+        source.insert(insert, __defines);
+
+        return source;
     }
 
     const std::string& Shader::GetName() const {
@@ -202,92 +391,233 @@ namespace Fleet::Core::Graphics {
     }
 
     void Shader::Bind() const {
-        glad_glUseProgram(RendererID);
+        Manager::UseProgram(RendererID);
     }
 
     void Shader::Unbind() const {
-        glad_glUseProgram(0);
+        Manager::UseProgram(0);
     }
 
     void Shader::SetInt(const std::string& _name, int _value) {
-        UploadUniformInt(_name, _value);
+        UploadUniformInt(Location(_name), _value);
     }
     void Shader::SetFloat(const std::string& _name, const float _value) {
-        UploadUniformFloat(_name, _value);
+        UploadUniformFloat(Location(_name), _value);
     }
     void Shader::SetFloat2(const std::string& _name, const glm::vec2& _value) {
-        UploadUniformFloat2(_name, _value);
+        UploadUniformFloat2(Location(_name), _value);
     }
     void Shader::SetFloat3(const std::string& _name, const glm::vec3& _value) {
-        UploadUniformFloat3(_name, _value);
+        UploadUniformFloat3(Location(_name), _value);
     }
     void Shader::SetFloat4(const std::string& _name, const glm::vec4& _value) {
-        UploadUniformFloat4(_name, _value);
+        UploadUniformFloat4(Location(_name), _value);
     }
     void Shader::SetMat3(const std::string& _name, const glm::mat3& _value) {
-        UploadUniformMat3(_name, _value);
+        UploadUniformMat3(Location(_name), _value);
     }
     void Shader::SetMat4(const std::string& _name, const glm::mat4& _value) {
-        UploadUniformMat4(_name, _value);
+        UploadUniformMat4(Location(_name), _value);
     }
     void Shader::SetBool(const std::string& _name, const bool _value) {
-        UploadUniformBool(_name, _value);
+        UploadUniformBool(Location(_name), _value);
     }
 
     void Shader::SetInt1v(const std::string& _name, const int _count, const int* _values) {
-        UploadUniformInt1v(_name, _count, _values);
+        UploadUniformInt1v(Location(_name), _count, _values);
     }
 
-    void Shader::UploadUniformInt(const std::string& _name, int _value) {
-        GLuint location = glad_glGetUniformLocation(RendererID, _name.c_str());
-        glad_glUniform1i(location, _value);
+    void Shader::SetInt(Uniform _uniform, int _value) {
+        UploadUniformInt(Location(_uniform), _value);
+    }
+    void Shader::SetFloat(Uniform _uniform, const float _value) {
+        UploadUniformFloat(Location(_uniform), _value);
+    }
+    void Shader::SetFloat2(Uniform _uniform, const glm::vec2& _value) {
+        UploadUniformFloat2(Location(_uniform), _value);
+    }
+    void Shader::SetFloat3(Uniform _uniform, const glm::vec3& _value) {
+        UploadUniformFloat3(Location(_uniform), _value);
+    }
+    void Shader::SetFloat4(Uniform _uniform, const glm::vec4& _value) {
+        UploadUniformFloat4(Location(_uniform), _value);
+    }
+    void Shader::SetMat3(Uniform _uniform, const glm::mat3& _value) {
+        UploadUniformMat3(Location(_uniform), _value);
+    }
+    void Shader::SetMat4(Uniform _uniform, const glm::mat4& _value) {
+        UploadUniformMat4(Location(_uniform), _value);
+    }
+    void Shader::SetBool(Uniform _uniform, const bool _value) {
+        UploadUniformBool(Location(_uniform), _value);
     }
 
-    void Shader::UploadUniformFloat(const std::string& _name, float _value) {
-        GLuint location = glad_glGetUniformLocation(RendererID, _name.c_str());
-        glad_glUniform1f(location, _value);
+    void Shader::SetInt1v(Uniform _uniform, const int _count, const int* _values) {
+        UploadUniformInt1v(Location(_uniform), _count, _values);
     }
-    void Shader::UploadUniformFloat2(const std::string& _name, const glm::vec2& _value) {
-        GLuint location = glad_glGetUniformLocation(RendererID, _name.c_str());
-        glad_glUniform2f(location, _value.x, _value.y);
+
+    // Program binary cache
+    bool Shader::LoadBinary(const std::string& _path) {
+
+        Cache::MappedFile file(_path);
+
+        ProgramCacheHeader header;
+
+        if (!file.IsOpen() || file.GetSize() < sizeof(header))
+            return false;
+
+        std::memcpy(&header, file.GetData(), sizeof(header));
+
+        if (std::memcmp(header.magic, ProgramCacheMagic, sizeof(ProgramCacheMagic)) != 0 || header.version != ProgramCacheVersion ||
+            file.GetSize() != sizeof(header) + header.length)
+            return false;
+
+        unsigned int program = glad_glCreateProgram();
+        glad_glProgramBinary(program, header.format, file.GetData() + sizeof(header), static_cast<GLsizei>(header.length));
+
+        // Drivers may reject binaries at any time (updates, different GPU), the caller compiles from source then
+        GLint isLinked = 0;
+        glad_glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+
+        if (isLinked == GL_FALSE) {
+            glad_glDeleteProgram(program);
+            return false;
+        }
+
+        RendererID = program;
+
+        return true;
     }
-    void Shader::UploadUniformFloat3(const std::string& _name, const glm::vec3& _value) {
-        GLuint location = glad_glGetUniformLocation(RendererID, _name.c_str());
-        glad_glUniform3f(location, _value.x, _value.y, _value.z);
+    void Shader::SaveBinary(const std::string& _path) const {
+
+        GLint length = 0;
+        glad_glGetProgramiv(RendererID, GL_PROGRAM_BINARY_LENGTH, &length);
+
+        // No binary formats supported
+        if (length <= 0)
+            return;
+
+        std::vector<unsigned char> data(sizeof(ProgramCacheHeader) + static_cast<size_t>(length));
+
+        GLenum format = 0;
+        GLsizei written = 0;
+        glad_glGetProgramBinary(RendererID, length, &written, &format, data.data() + sizeof(ProgramCacheHeader));
+
+        if (written <= 0)
+            return;
+
+        ProgramCacheHeader header = {};
+        std::memcpy(header.magic, ProgramCacheMagic, sizeof(ProgramCacheMagic));
+        header.version = ProgramCacheVersion;
+        header.format = format;
+        header.length = static_cast<uint32_t>(written);
+
+        std::memcpy(data.data(), &header, sizeof(header));
+        data.resize(sizeof(header) + static_cast<size_t>(written));
+
+        Cache::Write(_path, data);
     }
-    void Shader::UploadUniformFloat4(const std::string& _name, const glm::vec4& _value) {
-        GLuint location = glad_glGetUniformLocation(RendererID, _name.c_str());
-        glad_glUniform4f(location, _value.x, _value.y, _value.z, _value.w);
+
+    // Uniform reflection
+    void Shader::Reflect() {
+
+        uniforms.clear();
+        UniformLookup.clear();
+
+        GLint count = 0;
+        GLint MaxLength = 0;
+
+        glad_glGetProgramiv(RendererID, GL_ACTIVE_UNIFORMS, &count);
+        glad_glGetProgramiv(RendererID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &MaxLength);
+
+        std::vector<GLchar> buffer(static_cast<size_t>(MaxLength) + 1);
+
+        for (GLint i = 0; i < count; i++) {
+
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+
+            glad_glGetActiveUniform(RendererID, static_cast<GLuint>(i), static_cast<GLsizei>(buffer.size()), &length, &size, &type, buffer.data());
+
+            std::string __name(buffer.data(), length);
+
+            // Uniform block members have no location
+            int location = glad_glGetUniformLocation(RendererID, __name.c_str());
+
+            if (location < 0)
+                continue;
+
+            // Arrays are reported as their first element
+            if (__name.size() > 3 && __name.compare(__name.size() - 3, 3, "[0]") == 0)
+                __name.resize(__name.size() - 3);
+
+            UniformLookup.insert({ __name, static_cast<Uniform>(uniforms.size()) });
+            uniforms.push_back({ __name, location, type, size });
+        }
     }
 
-    void Shader::UploadUniformMat3(const std::string& _name, const glm::mat3& _matrix) {
-        GLuint location = glad_glGetUniformLocation(RendererID, _name.c_str());
-        glad_glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(_matrix));
+    const Uniform Shader::GetUniform(const std::string& _name) const {
+
+        auto found = UniformLookup.find(_name);
+
+        return (found == UniformLookup.end()) ? -1 : found->second;
     }
-    void Shader::UploadUniformMat4(const std::string& _name, const glm::mat4& _matrix) {
-        GLuint location = glad_glGetUniformLocation(RendererID, _name.c_str());
-        glad_glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(_matrix));
+
+    int Shader::Location(const std::string& _name) const {
+        return Location(GetUniform(_name));
     }
-    void Shader::UploadUniformBool(const std::string& _name, const bool _value) {
-        GLuint location = glad_glGetUniformLocation(RendererID, _name.c_str());
-        glad_glUniform1i(location, _value);
+    int Shader::Location(Uniform _uniform) const {
+        return (_uniform < 0 || _uniform >= static_cast<Uniform>(uniforms.size())) ? -1 : uniforms[_uniform].location;
     }
 
-    void Shader::UploadUniformInt1v(const std::string& _name, const int _count, const int* _values) {
-        GLuint location = glad_glGetUniformLocation(RendererID, _name.c_str());
-        glad_glUniform1iv(location, _count, _values);
+    // Inactive uniforms (location -1) are ignored by GL
+    void Shader::UploadUniformInt(int _location, int _value) {
+        glad_glProgramUniform1i(RendererID, _location, _value);
     }
 
-    ShaderLibrary::ShaderLibrary(const std::string& _libraryPath) {
-        init(_libraryPath);
+    void Shader::UploadUniformFloat(int _location, float _value) {
+        glad_glProgramUniform1f(RendererID, _location, _value);
+    }
+    void Shader::UploadUniformFloat2(int _location, const glm::vec2& _value) {
+        glad_glProgramUniform2f(RendererID, _location, _value.x, _value.y);
+    }
+    void Shader::UploadUniformFloat3(int _location, const glm::vec3& _value) {
+        glad_glProgramUniform3f(RendererID, _location, _value.x, _value.y, _value.z);
+    }
+    void Shader::UploadUniformFloat4(int _location, const glm::vec4& _value) {
+        glad_glProgramUniform4f(RendererID, _location, _value.x, _value.y, _value.z, _value.w);
+    }
+
+    void Shader::UploadUniformMat3(int _location, const glm::mat3& _matrix) {
+        glad_glProgramUniformMatrix3fv(RendererID, _location, 1, GL_FALSE, glm::value_ptr(_matrix));
+    }
+    void Shader::UploadUniformMat4(int _location, const glm::mat4& _matrix) {
+        glad_glProgramUniformMatrix4fv(RendererID, _location, 1, GL_FALSE, glm::value_ptr(_matrix));
+    }
+    void Shader::UploadUniformBool(int _location, const bool _value) {
+        glad_glProgramUniform1i(RendererID, _location, _value);
+    }
+
+    void Shader::UploadUniformInt1v(int _location, const int _count, const int* _values) {
+        glad_glProgramUniform1iv(RendererID, _location, _count, _values);
+    }
+
+    ShaderLibrary::ShaderLibrary(const std::string& _libraryPath, const ShaderDefines& _defines) {
+        init(_libraryPath, _defines);
     }
     ShaderLibrary::~ShaderLibrary() {
 
     }
 
-    int ShaderLibrary::init(const std::string& _LibraryPath) {
+    int ShaderLibrary::init(const std::string& _LibraryPath, const ShaderDefines& _defines) {
+
+        // Let the driver use as many compiler threads as it likes
+        if (GLAD_GL_KHR_parallel_shader_compile)
+            glad_glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
 
         LibraryPath = _LibraryPath;
+        defines = _defines;
         AddLibrary(_LibraryPath);
 
         return 0;
@@ -306,10 +636,124 @@ namespace Fleet::Core::Graphics {
 
         for (std::string __line; std::getline(iss, __line); ) {
 
-            std::vector<std::string> __data = ASWL::Utilities::split(__line, ';');
-            std::shared_ptr<Shader> shader = std::make_shared<Shader>(Shader(__data[0], ASWL::Utilities::strip(__data[2], "\r"), __data[1]));
-            map.insert({ __data[0], shader });
+            std::vector<std::string> __data = ASWL::Utilities::split(ASWL::Utilities::strip(__line, "\r"), ';');
+
+            if (__data.size() < 3)
+                continue;
+
+            Source source = { __data[2], __data[1], {} };
+
+            // Optional define list -> DEFINE,DEFINE=value
+            if (__data.size() > 3) {
+
+                for (const std::string& define : ASWL::Utilities::split(__data[3], ',')) {
+
+                    if (define.empty())
+                        continue;
+
+                    size_t equals = define.find('=');
+
+                    if (equals == std::string::npos)
+                        source.defines[define] = "";
+                    else
+                        source.defines[define.substr(0, equals)] = define.substr(equals + 1);
+                }
+            }
+
+            sources.insert({ __data[0], source });
+        }
+    }
+
+    void ShaderLibrary::Prewarm() {
+
+        if (!GLAD_GL_KHR_parallel_shader_compile)
+            return;
+
+        for (const auto& [__name, source] : sources)
+            Prewarm(__name, {});
+    }
+    void ShaderLibrary::Prewarm(const std::vector<std::string>& _names) {
+
+        if (!GLAD_GL_KHR_parallel_shader_compile)
+            return;
+
+        for (const std::string& __name : _names)
+            Prewarm(__name, {});
+    }
+    bool ShaderLibrary::Prewarm(const std::string& _name, const ShaderDefines& _defines) {
+
+        auto source = sources.find(_name);
+
+        if (source == sources.end())
+            return false;
+
+        std::string key = PermutationKey(_name, _defines);
+
+        if (map.find(key) != map.end() || pending.find(key) != pending.end())
+            return true;
+
+        ShaderDefines __defines = defines;
+
+        for (const auto& [define, value] : source->second.defines)
+            __defines[define] = value;
+
+        for (const auto& [define, value] : _defines)
+            __defines[define] = value;
+
+        std::shared_ptr<Shader> shader = std::make_shared<Shader>();
+        shader->Compile(key, source->second.vtxPath, source->second.frgPath, __defines);
+
+        pending.insert({ key, shader });
+
+        return true;
+    }
+
+    const std::shared_ptr<Shader>& ShaderLibrary::Get(const std::string& _name) {
+        return Get(_name, {});
+    }
+    const std::shared_ptr<Shader>& ShaderLibrary::Get(const std::string& _name, const ShaderDefines& _defines) {
+
+        static const std::shared_ptr<Shader> none;
+
+        std::string key = PermutationKey(_name, _defines);
+        auto found = map.find(key);
+
+        if (found != map.end())
+            return found->second;
+
+        // Not prewarmed, start it now
+        if (!Prewarm(_name, _defines)) {
+
+            ASWL::Logger::logger("S0003", "Error: Unknown shader [", _name, "].");
+            return none;
         }
+
+        auto compiling = pending.find(key);
+        std::shared_ptr<Shader> shader = compiling->second;
+        pending.erase(compiling);
+
+        // Failed shaders stay in the library with RendererID 0, they were logged and aren't retried every frame
+        shader->Finish();
+
+        return map.insert({ key, shader }).first->second;
+    }
+
+    std::string ShaderLibrary::PermutationKey(const std::string& _name, const ShaderDefines& _defines) {
+
+        if (_defines.empty())
+            return _name;
+
+        std::string key = _name + '[';
+
+        for (const auto& [define, value] : _defines) {
+
+            if (key.back() != '[')
+                key += ',';
+
+            key += value.empty() ? define : define + '=' + value;
+        }
+
+        return key + ']';
     }
 
     const std::map<std::string, std::shared_ptr<Shader>>& ShaderLibrary::GetMap() const {
@@ -28,8 +28,11 @@
 
 // Include standard library
 #include <map>
+#include <array>
 #include <string>
 #include <memory>
+#include <vector>
+#include <unordered_map>
 
 // Include dependencies
 #include <glad/glad.h>
@@ -51,9 +54,21 @@ namespace Fleet::Core::Graphics {
     int ShaderDataTypeSize(ShaderDataType type);
     GLenum ShaderTypeToGLBaseType(ShaderDataType type);
 
+    // Handle into a shader's uniform table, -1 -> not an active uniform. Handles are only valid for the shader
+    // that returned them. Setting -1 is a no-op.
+    using Uniform = int;
+
+    // Injected #defines, name -> value (empty for a bare #define). Ordered, so a define set always has the same key.
+    using ShaderDefines = std::map<std::string, std::string>;
+
     class Shader {
 
-        /// Shader loader class
+        /// Shader loader class. Active uniforms are reflected once at link time, so setters never ask the driver
+        /// for locations. Uniforms are set with glProgramUniform*, the shader doesn't have to be bound.
+        /// init compiles and links in one go. Compile only hands the sources to the driver, Finish waits for the
+        /// result, so the driver can compile several programs at once (GL_KHR_parallel_shader_compile).
+        /// Sources are preprocessed first: #include "file" is resolved relative to the including file (each file is
+        /// included once) and defines are injected after #version.
 
     public:
 
@@ -64,6 +79,10 @@ namespace Fleet::Core::Graphics {
         void init(const std::string& vtxPath, const std::string& frgPath);
         void init(const std::string& _name, const std::string& vtxPath, const std::string& frgPath);
 
+        void Compile(const std::string& vtxPath, const std::string& frgPath, const ShaderDefines& _defines = {});
+        void Compile(const std::string& _name, const std::string& vtxPath, const std::string& frgPath, const ShaderDefines& _defines = {});
+        bool Finish();                          // Blocks until linked, false if compiling or linking failed
+
         void Bind() const;
         void Unbind() const;
 
@@ -78,49 +97,118 @@ namespace Fleet::Core::Graphics {
 
         void SetInt1v(const std::string& _name, const int _count, const int* _values);
 
+        // Handle based setters, look the handle up once with GetUniform
+        void SetInt(Uniform _uniform, int _value);
+        void SetFloat(Uniform _uniform, const float _value);
+        void SetFloat2(Uniform _uniform, const glm::vec2& _value);
+        void SetFloat3(Uniform _uniform, const glm::vec3& _value);
+        void SetFloat4(Uniform _uniform, const glm::vec4& _value);
+        void SetMat3(Uniform _uniform, const glm::mat3& _value);
+        void SetMat4(Uniform _uniform, const glm::mat4& _value);
+        void SetBool(Uniform _uniform, const bool _value);
+
+        void SetInt1v(Uniform _uniform, const int _count, const int* _values);
+
         // Getters
         const std::string& GetName() const;
         const unsigned int GetRendererID() const;
+        const Uniform GetUniform(const std::string& _name) const;     // Arrays are found by their name without "[0]"
+        const bool IsReady() const;             // Finish won't block
+
+        static std::string Preprocess(const std::string& _path, const ShaderDefines& _defines = {});
 
     private:
 
-        void UploadUniformInt(const std::string& _name, int _value);
-        void UploadUniformFloat(const std::string& _name, float _value);
-        void UploadUniformFloat2(const std::string& _name, const glm::vec2& _value);
-        void UploadUniformFloat3(const std::string& _name, const glm::vec3& _value);
-        void UploadUniformFloat4(const std::string& _name, const glm::vec4& _value);
-        void UploadUniformMat3(const std::string& _name, const glm::mat3& _matrix);
-        void UploadUniformMat4(const std::string& _name, const glm::mat4& _matrix);
-        void UploadUniformBool(const std::string& _name, const bool _value);
+        struct UniformInfo {
+            std::string name;
+            int location;
+            GLenum type;
+            int size;               // Array length, 1 otherwise
+        };
+
+        void Reflect();
+
+        // Program binary cache (cache/shaders), keyed by the sources and the driver
+        bool LoadBinary(const std::string& _path);
+        void SaveBinary(const std::string& _path) const;
+
+        int Location(const std::string& _name) const;
+        int Location(Uniform _uniform) const;
+
+        void UploadUniformInt(int _location, int _value);
+        void UploadUniformFloat(int _location, float _value);
+        void UploadUniformFloat2(int _location, const glm::vec2& _value);
+        void UploadUniformFloat3(int _location, const glm::vec3& _value);
+        void UploadUniformFloat4(int _location, const glm::vec4& _value);
+        void UploadUniformMat3(int _location, const glm::mat3& _matrix);
+        void UploadUniformMat4(int _location, const glm::mat4& _matrix);
+        void UploadUniformBool(int _location, const bool _value);
 
-        void UploadUniformInt1v(const std::string& _name, const int _count, const int* _values);
+        void UploadUniformInt1v(int _location, const int _count, const int* _values);
 
-        unsigned int RendererID;
+        unsigned int RendererID = 0;
         std::string name;
+
+        // Compile -> Finish state
+        bool pending = false;
+        std::array<unsigned int, 2> stages = {};
+        std::string CachePath;
+
+        std::vector<UniformInfo> uniforms;                          // Flat table, indexed by handle
+        std::unordered_map<std::string, Uniform> UniformLookup;     // Only used by GetUniform & the name setters
     };
 
 
-    // TODO
     class ShaderLibrary {
-        
+
+        /// Shader library class. Entries are read from the library file, but only compiled on first use (Get)
+        /// or when prewarmed. Library file lines are name;fragment;vertex[;DEFINE,DEFINE=value,...].
+        /// Each define set of an entry is its own program (permutation), compiled once and cached by name and set.
+        /// Library wide defines are applied first, then the entry's, then the ones passed to Get.
+
     public:
 
         ShaderLibrary() = default;
-        ShaderLibrary(const std::string& _LibraryPath);
+        ShaderLibrary(const std::string& _LibraryPath, const ShaderDefines& _defines = {});
         ~ShaderLibrary();
 
-        int init(const std::string& _LibraryPath);
+        int init(const std::string& _LibraryPath, const ShaderDefines& _defines = {});
 
         void AddShader(std::shared_ptr<Shader>& _shader);
         void AddShader(const std::string& _name, const std::string& _vtxPath, const std::string& _frgPath);
         void AddLibrary(const std::string& _LibraryPath);
 
-        const std::map<std::string, std::shared_ptr<Shader>>& GetMap() const;
+        // Start compiling in the background. Without GL_KHR_parallel_shader_compile compiling would block, so
+        // nothing is started and shaders compile on first use instead.
+        void Prewarm();
+        void Prewarm(const std::vector<std::string>& _names);
+
+        // Compiles the shader if it wasn't, or waits for it if it is still being prewarmed. nullptr if unknown.
+        const std::shared_ptr<Shader>& Get(const std::string& _name);
+        const std::shared_ptr<Shader>& Get(const std::string& _name, const ShaderDefines& _defines);
+
+        const std::map<std::string, std::shared_ptr<Shader>>& GetMap() const;     // Compiled permutations only
+
+        // name for the entry's own define set, name[DEFINE,DEFINE=value] otherwise
+        static std::string PermutationKey(const std::string& _name, const ShaderDefines& _defines);
 
     private:
 
+        struct Source {
+            std::string vtxPath;
+            std::string frgPath;
+            ShaderDefines defines;
+        };
+
+        // Starts compiling a permutation unless it already is, false if the entry is unknown
+        bool Prewarm(const std::string& _name, const ShaderDefines& _defines);
+
         std::string LibraryPath;
-        std::map<std::string, std::shared_ptr<Shader>> map;
+        ShaderDefines defines;                                          // Library wide
+
+        std::map<std::string, Source> sources;                          // Entries by name
+        std::map<std::string, std::shared_ptr<Shader>> pending;         // Compiling, by permutation key
+        std::map<std::string, std::shared_ptr<Shader>> map;             // Compiled, by permutation key
     };
 }
 
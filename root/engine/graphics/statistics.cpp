@@ -0,0 +1,101 @@
+// Fleet : engine/graphics/statistics.cpp (c) 2021 Andrew Woo
+
+/* Modified MIT License
+ *
+ * Copyright 2021 Andrew Woo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * Restrictions:
+ >  The Software may not be sold unless significant, mechanics changing modifications are made by the seller, or unless the buyer
+ >  understands an unmodified version of the Software is available elsewhere free of charge, and agrees to buy the Software given
+ >  this knowledge.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "statistics.hpp"
+
+// Include standard library
+#include <utility>
+
+namespace Fleet::Core::Graphics::Statistics {
+
+    struct StatisticsData {
+
+        FrameStatistics current;
+        FrameStatistics last;
+
+        bool InScene = false;
+    };
+
+    static StatisticsData sData;
+
+    // Every counter goes to the frame total, and to the open scene if there is one
+    template<typename T> static void Count(T Counters::* _counter, T _value) {
+
+        sData.current.total.*_counter += _value;
+
+        if (sData.InScene)
+            sData.current.scenes.back().counters.*_counter += _value;
+    }
+
+    void BeginFrame() {
+
+        // Swap instead of copy, so the scene vectors keep their capacity between frames
+        std::swap(sData.current, sData.last);
+
+        sData.current.frame = sData.last.frame + 1;
+        sData.current.total = Counters();
+        sData.current.scenes.clear();
+
+        sData.InScene = false;
+    }
+    void BeginScene(const std::string& _shader) {
+
+        sData.current.scenes.push_back({ _shader, Counters() });
+        sData.InScene = true;
+    }
+    void EndScene() {
+        sData.InScene = false;
+    }
+
+    void CountDrawCall() {
+        Count(&Counters::DrawCalls, 1u);
+    }
+    void CountFlush() {
+        Count(&Counters::Flushes, 1u);
+    }
+    void CountQuads(uint32_t _count) {
+        Count(&Counters::Quads, _count);
+    }
+    void CountSprites(uint32_t _count) {
+        Count(&Counters::Sprites, _count);
+    }
+    void CountTextureBind() {
+        Count(&Counters::TextureBinds, 1u);
+    }
+    void CountShaderBind() {
+        Count(&Counters::ShaderBinds, 1u);
+    }
+    void CountSkippedBind() {
+        Count(&Counters::SkippedBinds, 1u);
+    }
+    void CountBytesUploaded(uint64_t _bytes) {
+        Count(&Counters::BytesUploaded, _bytes);
+    }
+
+    const FrameStatistics& GetCurrentFrame() {
+        return sData.current;
+    }
+    const FrameStatistics& GetLastFrame() {
+        return sData.last;
+    }
+}
@@ -0,0 +1,79 @@
+// Fleet : engine/graphics/statistics.hpp (c) 2021 Andrew Woo
+
+/* Modified MIT License
+ *
+ * Copyright 2021 Andrew Woo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * Restrictions:
+ >  The Software may not be sold unless significant, mechanics changing modifications are made by the seller, or unless the buyer
+ >  understands an unmodified version of the Software is available elsewhere free of charge, and agrees to buy the Software given
+ >  this knowledge.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#ifndef FLEET_ENGINE_GRAPHICS_STATISTICS
+#define FLEET_ENGINE_GRAPHICS_STATISTICS
+
+// Include standard library
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace Fleet::Core::Graphics::Statistics {
+
+    struct Counters {
+
+        uint32_t DrawCalls = 0;
+        uint32_t Flushes = 0;
+        uint32_t Quads = 0;
+        uint32_t Sprites = 0;
+        uint32_t TextureBinds = 0;          // Binds sent to the driver, see SkippedBinds
+        uint32_t ShaderBinds = 0;
+        uint32_t SkippedBinds = 0;          // Binds the state cache didn't send to the driver
+        uint64_t BytesUploaded = 0;         // Vertex and instance data written to the streaming buffers
+    };
+
+    struct SceneStatistics {
+        std::string shader;
+        Counters counters;
+    };
+
+    struct FrameStatistics {
+        uint64_t frame = 0;
+        Counters total;                     // Includes work done outside of a scene
+        std::vector<SceneStatistics> scenes;
+    };
+
+    // Frame control. BeginFrame completes the previous frame, which then becomes the last frame.
+    void BeginFrame();
+    void BeginScene(const std::string& _shader);
+    void EndScene();
+
+    // Counters
+    void CountDrawCall();
+    void CountFlush();
+    void CountQuads(uint32_t _count = 1);
+    void CountSprites(uint32_t _count = 1);
+    void CountTextureBind();
+    void CountShaderBind();
+    void CountSkippedBind();
+    void CountBytesUploaded(uint64_t _bytes);
+
+    // Getters
+    const FrameStatistics& GetCurrentFrame();
+    const FrameStatistics& GetLastFrame();
+}
+
+#endif // !FLEET_ENGINE_GRAPHICS_STATISTICS
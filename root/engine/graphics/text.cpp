@@ -0,0 +1,129 @@
+// Fleet : engine/graphics/text.cpp (c) 2021 Andrew Woo
+
+/* Modified MIT License
+ *
+ * Copyright 2021 Andrew Woo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * Restrictions:
+ >  The Software may not be sold unless significant, mechanics changing modifications are made by the seller, or unless the buyer
+ >  understands an unmodified version of the Software is available elsewhere free of charge, and agrees to buy the Software given
+ >  this knowledge.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "text.hpp"
+
+// Include standard library
+#include <vector>
+#include <algorithm>
+
+// Include dependencies
+#include <ASWL/logger.hpp>
+
+// Include Fleet libraries
+#include "statistics.hpp"
+
+namespace Fleet::Core::Graphics {
+
+    StaticText::StaticText(const std::string& _string, const Renderer::render_data& _data, const std::shared_ptr<Font>& _font) {
+
+        string = _string;
+        data = _data;
+        font = _font;
+    }
+
+    void StaticText::SetString(const std::string& _string) {
+
+        if (_string == string)
+            return;
+
+        string = _string;
+        dirty = true;
+    }
+    void StaticText::SetTransform(const Renderer::render_data& _data) {
+
+        data = _data;
+        dirty = true;
+    }
+    void StaticText::SetFont(const std::shared_ptr<Font>& _font) {
+
+        font = _font;
+        dirty = true;
+    }
+
+    void StaticText::Build() {
+
+        dirty = false;
+
+        vtxArray.reset();
+        vtxBuffer.reset();
+        IndexCount = 0;
+
+        if (!font || string.empty())
+            return;
+
+        // Same layout as dynamic text
+        Renderer::CommandArena arena;
+        arena.RenderText(string, data, font);
+
+        const auto& quads = arena.GetQuads();
+        size_t count = std::min<size_t>(quads.size(), Renderer::GetMaxQuads());
+
+        if (count < quads.size())
+            ASWL::Logger::logger("ST001", "Error: Static text exceeds the quad limit, truncated [", string, "].");
+
+        // The font is bound to slot 1 when the text is drawn
+        std::vector<Vertex> vertices;
+        vertices.reserve(count * 4);
+
+        for (size_t i = 0; i < count; i++) {
+            for (size_t v = 0; v < 4; v++)
+                vertices.push_back({ quads[i].vertices[v], quads[i].texcoords[v], quads[i].color, 1.f, quads[i].mode });
+        }
+
+        uint32_t size = static_cast<uint32_t>(vertices.size() * sizeof(Vertex));
+
+        vtxBuffer = std::make_shared<VertexBuffer>();
+        vtxBuffer->CreateStatic(vertices.data(), size);
+        vtxBuffer->SetLayout({ { ShaderDataType::Float3, "a_Position" },
+                               { ShaderDataType::Float2, "a_TexCoord" },
+                               { ShaderDataType::Float4, "a_Color"},
+                               { ShaderDataType::Float, "a_TexSlot"},
+                               { ShaderDataType::Float, "a_Mode"} });
+
+        vtxArray = std::make_unique<VertexArray>();
+        vtxArray->AddVertexBuffer(vtxBuffer);
+        vtxArray->SetIndexBuffer(Renderer::GetQuadIndexBuffer());
+
+        IndexCount = static_cast<uint32_t>(count * 6);
+
+        Statistics::CountBytesUploaded(size);
+    }
+
+    // Getters
+    const bool StaticText::IsDirty() const {
+        return dirty;
+    }
+    const std::string& StaticText::GetString() const {
+        return string;
+    }
+    const std::shared_ptr<Font>& StaticText::GetFont() const {
+        return font;
+    }
+    const std::unique_ptr<VertexArray>& StaticText::GetVertexArray() const {
+        return vtxArray;
+    }
+    const uint32_t StaticText::GetIndexCount() const {
+        return IndexCount;
+    }
+}
@@ -0,0 +1,77 @@
+// Fleet : engine/graphics/text.hpp (c) 2021 Andrew Woo
+
+/* Modified MIT License
+ *
+ * Copyright 2021 Andrew Woo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * Restrictions:
+ >  The Software may not be sold unless significant, mechanics changing modifications are made by the seller, or unless the buyer
+ >  understands an unmodified version of the Software is available elsewhere free of charge, and agrees to buy the Software given
+ >  this knowledge.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#ifndef FLEET_ENGINE_GRAPHICS_TEXT
+#define FLEET_ENGINE_GRAPHICS_TEXT
+
+// Include standard library
+#include <string>
+#include <memory>
+
+// Include Fleet libraries
+#include "font.hpp"
+#include "vertex.hpp"
+#include "renderer.hpp"
+
+namespace Fleet::Core::Graphics {
+
+    class StaticText {
+
+        /// Text laid out once into its own immutable vertex buffer and drawn with a single call.
+        /// Only rebuilt (on the GL thread) after its string, transform or font changed.
+
+    public:
+
+        StaticText() = default;
+        StaticText(const std::string& _string, const Renderer::render_data& _data, const std::shared_ptr<Font>& _font);
+
+        void SetString(const std::string& _string);
+        void SetTransform(const Renderer::render_data& _data);
+        void SetFont(const std::shared_ptr<Font>& _font);
+
+        void Build();
+
+        // Getters
+        const bool IsDirty() const;
+        const std::string& GetString() const;
+        const std::shared_ptr<Font>& GetFont() const;
+        const std::unique_ptr<VertexArray>& GetVertexArray() const;
+        const uint32_t GetIndexCount() const;
+
+    private:
+
+        std::string string;
+        Renderer::render_data data {};
+        std::shared_ptr<Font> font;
+
+        std::unique_ptr<VertexArray> vtxArray;
+        std::shared_ptr<VertexBuffer> vtxBuffer;
+        uint32_t IndexCount = 0;
+
+        bool dirty = true;
+    };
+}
+
+#endif // !FLEET_ENGINE_GRAPHICS_TEXT
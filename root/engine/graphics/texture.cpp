@@ -28,6 +28,8 @@
 
 #include <ASWL/logger.hpp>
 
+#include "manager.hpp"
+
 namespace Fleet::Core::Graphics {
 
     Texture::Texture(const glm::vec2& _dimensions) : dimensions(_dimensions) {
@@ -99,6 +101,7 @@ namespace Fleet::Core::Graphics {
     }
 
     Texture::~Texture() {
+        Manager::ForgetTexture(TextureID);
         glad_glDeleteTextures(1, &TextureID);
     }
 
@@ -174,8 +177,22 @@ namespace Fleet::Core::Graphics {
         glad_glTextureSubImage2D(TextureID, 0, 0, 0, dimensions.x, dimensions.y, DataFormat, GL_UNSIGNED_BYTE, _data);
     }
 
+    void Texture::SetSubData(const void* _data, const glm::vec2& _offset, const glm::vec2& _size) {
+
+        if (_offset.x + _size.x > dimensions.x || _offset.y + _size.y > dimensions.y) {
+            ASWL::Logger::logger("T0004", "Error: Sub image exceeds texture dimensions.");
+            return;
+        }
+
+        glad_glTextureSubImage2D(TextureID, 0, _offset.x, _offset.y, _size.x, _size.y, DataFormat, GL_UNSIGNED_BYTE, _data);
+    }
+
+    void Texture::Sync() {
+
+    }
+
     void Texture::Bind(unsigned int _slot) const {
-        glad_glBindTextureUnit(_slot, TextureID);
+        Manager::BindTextureUnit(_slot, TextureID);
     }
 
     const unsigned int Texture::GetTextureID() const {
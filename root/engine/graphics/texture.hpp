@@ -51,8 +51,11 @@ namespace Fleet::Core::Graphics {
         const glm::vec2& GetDimensions() const;
 
         void SetData(void* _data, unsigned int _size);
+        void SetSubData(const void* _data, const glm::vec2& _offset, const glm::vec2& _size);
         void Bind(unsigned int _slot = 1) const;
 
+        virtual void Sync();        // Uploads pending CPU side changes (GL thread), nothing to do for plain textures
+
         const unsigned int GetTextureID() const;
 
         bool operator== (const Texture& other);
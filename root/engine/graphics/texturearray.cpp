@@ -0,0 +1,201 @@
+// Fleet : engine/graphics/texturearray.cpp (c) 2021 Andrew Woo
+
+/* Modified MIT License
+ *
+ * Copyright 2021 Andrew Woo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * Restrictions:
+ >  The Software may not be sold unless significant, mechanics changing modifications are made by the seller, or unless the buyer
+ >  understands an unmodified version of the Software is available elsewhere free of charge, and agrees to buy the Software given
+ >  this knowledge.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "texturearray.hpp"
+
+// Include standard library
+#include <vector>
+#include <cstring>
+#include <algorithm>
+
+// Include dependencies
+#include <STB/stb_image.h>
+#include <ASWL/logger.hpp>
+
+namespace Fleet::Core::Graphics {
+
+    TextureArray::TextureArray(int _size, int _layers) {
+
+        size = _size;
+        layers = _layers;
+        used = 0;
+
+        dimensions = glm::vec2(_size, _size);
+
+        InternalFormat = GL_RGBA8;
+        DataFormat = GL_RGBA;
+
+        glad_glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &TextureID);
+        glad_glTextureStorage3D(TextureID, 1, InternalFormat, size, size, layers);
+
+        // Immutable storage starts out undefined
+        glad_glClearTexImage(TextureID, 0, DataFormat, GL_UNSIGNED_BYTE, nullptr);
+
+        // Same filters as Texture and the atlas pages, so a sprite looks the same whichever way it's stored. Magnified
+        // texels stay sharp, minified ones are blended, and that's where the extruded layer edges keep samples inside
+        // the image.
+        glad_glTextureParameteri(TextureID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glad_glTextureParameteri(TextureID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        glad_glTextureParameteri(TextureID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glad_glTextureParameteri(TextureID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+
+    int TextureArray::AddLayer(const void* _data, int _width, int _height) {
+
+        if (IsFull() || _width > size || _height > size)
+            return -1;
+
+        // Textures smaller than the layer repeat their last column and row once, so linear filtering at the edge
+        // of the sub rect doesn't blend in the cleared texels
+        int width = std::min(_width + 1, size);
+        int height = std::min(_height + 1, size);
+
+        if (width == _width && height == _height) {
+            glad_glTextureSubImage3D(TextureID, 0, 0, 0, used, _width, _height, 1, DataFormat, GL_UNSIGNED_BYTE, _data);
+            return used++;
+        }
+
+        const uint8_t* src = static_cast<const uint8_t*>(_data);
+        std::vector<uint8_t> extruded(static_cast<size_t>(width) * height * 4);
+
+        for (int y = 0; y < height; y++) {
+
+            const uint8_t* row = src + static_cast<size_t>(std::min(y, _height - 1)) * _width * 4;
+            uint8_t* dst = extruded.data() + static_cast<size_t>(y) * width * 4;
+
+            std::memcpy(dst, row, static_cast<size_t>(_width) * 4);
+
+            if (width > _width)
+                std::memcpy(dst + static_cast<size_t>(_width) * 4, row + static_cast<size_t>(_width - 1) * 4, 4);
+        }
+
+        glad_glTextureSubImage3D(TextureID, 0, 0, 0, used, width, height, 1, DataFormat, GL_UNSIGNED_BYTE, extruded.data());
+
+        return used++;
+    }
+
+    const int TextureArray::GetLayerSize() const {
+        return size;
+    }
+    const int TextureArray::GetLayerCount() const {
+        return used;
+    }
+    const bool TextureArray::IsFull() const {
+        return used >= layers;
+    }
+
+    // Texture Array Library
+    TextureArrayLibrary::TextureArrayLibrary(size_t _ArrayBytes, int _MinSize, int _MaxSize) {
+
+        MaxLayers = 0;
+        glad_glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &MaxLayers);
+
+        ArrayBytes = _ArrayBytes;
+        MinSize = _MinSize;
+        MaxSize = _MaxSize;
+    }
+
+    const std::shared_ptr<TextureLayer>& TextureArrayLibrary::Add(const std::string& _path) {
+
+        auto cached = layers.find(_path);
+        if (cached != layers.end())
+            return cached->second;
+
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+
+        stbi_set_flip_vertically_on_load(true);
+        stbi_uc* data = stbi_load(_path.c_str(), &width, &height, &channels, 4);
+
+        if (!data) {
+            ASWL::Logger::logger("TL001", "Error: Failed to load image -> !stbi_load() [", _path, "].");
+            return empty;
+        }
+
+        int size = SizeClass(width, height);
+
+        if (size == 0) {
+            ASWL::Logger::logger("TL002", "Error: Texture exceeds the largest size class [", _path, "].");
+            stbi_image_free(data);
+            return empty;
+        }
+
+        std::vector<std::shared_ptr<TextureArray>>& group = arrays[size];
+
+        if (group.empty() || group.back()->IsFull())
+            group.push_back(std::make_shared<TextureArray>(size, LayersPerArray(size)));
+
+        int layer = group.back()->AddLayer(data, width, height);
+
+        stbi_image_free(data);
+
+        float u = static_cast<float>(width) / size;
+        float v = static_cast<float>(height) / size;
+
+        auto texture = std::make_shared<TextureLayer>();
+        texture->array = group.back();
+        texture->layer = static_cast<float>(layer);
+        texture->dimensions = glm::vec2(width, height);
+        texture->TexRect = { 0.f, 0.f, u, v };
+        texture->TexCoords = { glm::vec2(0.f, 0.f), glm::vec2(u, 0.f), glm::vec2(u, v), glm::vec2(0.f, v) };
+
+        return layers.insert({ _path, texture }).first->second;
+    }
+
+    const std::shared_ptr<TextureLayer>& TextureArrayLibrary::Get(const std::string& _path) {
+
+        auto texture = layers.find(_path);
+        return (texture == layers.end()) ? empty : texture->second;
+    }
+
+    const size_t TextureArrayLibrary::GetArrayCount() const {
+
+        size_t count = 0;
+
+        for (const auto& [size, group] : arrays)
+            count += group.size();
+
+        return count;
+    }
+
+    int TextureArrayLibrary::SizeClass(int _width, int _height) const {
+
+        int size = MinSize;
+
+        while (size < std::max(_width, _height))
+            size *= 2;
+
+        return (size > MaxSize) ? 0 : size;
+    }
+
+    // RGBA8 layers that fit the array budget, at least one
+    int TextureArrayLibrary::LayersPerArray(int _size) const {
+
+        size_t LayerBytes = static_cast<size_t>(_size) * _size * 4;
+        int count = static_cast<int>(std::clamp<size_t>(ArrayBytes / LayerBytes, 1, MaxLayersPerArray));
+
+        return (MaxLayers > 0) ? std::min(count, MaxLayers) : count;
+    }
+}
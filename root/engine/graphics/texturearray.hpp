@@ -0,0 +1,109 @@
+// Fleet : engine/graphics/texturearray.hpp (c) 2021 Andrew Woo
+
+/* Modified MIT License
+ *
+ * Copyright 2021 Andrew Woo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * Restrictions:
+ >  The Software may not be sold unless significant, mechanics changing modifications are made by the seller, or unless the buyer
+ >  understands an unmodified version of the Software is available elsewhere free of charge, and agrees to buy the Software given
+ >  this knowledge.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#ifndef FLEET_ENGINE_GRAPHICS_TEXTUREARRAY
+#define FLEET_ENGINE_GRAPHICS_TEXTUREARRAY
+
+// Include standard library
+#include <map>
+#include <array>
+#include <string>
+#include <vector>
+#include <memory>
+
+// Include dependencies
+#include <GLM/glm/glm.hpp>
+
+// Include Fleet libraries
+#include "texture.hpp"
+
+namespace Fleet::Core::Graphics {
+
+    class TextureArray : public Texture {
+
+        /// GL_TEXTURE_2D_ARRAY of equally sized RGBA8 layers
+
+    public:
+
+        TextureArray(int _size, int _layers);
+
+        int AddLayer(const void* _data, int _width, int _height);     // Returns the new layer, or -1 if the array is full
+
+        const int GetLayerSize() const;
+        const int GetLayerCount() const;
+        const bool IsFull() const;
+
+    private:
+
+        int size;
+        int layers;
+        int used;
+    };
+
+    struct TextureLayer {
+
+        std::shared_ptr<TextureArray> array;        // Array of the texture's size class
+        float layer;                                // Layer index inside the array
+        glm::vec2 dimensions;                       // Texture size in pixels
+
+        std::array<glm::vec2, 4> TexCoords;         // Bottom left to top left counter clockwise
+        glm::vec4 TexRect;                          // { u0, v0, u1, v1 }, textures smaller than their size class use a sub rect
+    };
+
+    class TextureArrayLibrary {
+
+        /// Groups textures into texture arrays by (power of two) size class. Every array gets the same memory
+        /// budget (16 MiB by default, 2048px -> 1 layer, 256px -> 64 layers), small size classes are capped at
+        /// MaxLayersPerArray so their first texture doesn't allocate the whole budget.
+
+    public:
+
+        TextureArrayLibrary(size_t _ArrayBytes = 16 << 20, int _MinSize = 32, int _MaxSize = 2048);
+
+        const std::shared_ptr<TextureLayer>& Add(const std::string& _path);
+        const std::shared_ptr<TextureLayer>& Get(const std::string& _path);
+
+        const size_t GetArrayCount() const;
+
+    private:
+
+        int SizeClass(int _width, int _height) const;
+        int LayersPerArray(int _size) const;
+
+        static constexpr int MaxLayersPerArray = 256;
+
+        size_t ArrayBytes;
+        int MaxLayers;                              // GL_MAX_ARRAY_TEXTURE_LAYERS
+        int MinSize;
+        int MaxSize;
+
+        std::map<int, std::vector<std::shared_ptr<TextureArray>>> arrays;
+        std::map<std::string, std::shared_ptr<TextureLayer>> layers;
+
+        std::shared_ptr<TextureLayer> empty;
+    };
+}
+
+#endif // !FLEET_ENGINE_GRAPHICS_TEXTUREARRAY
@@ -25,6 +25,8 @@
 
 #include <ASWL/logger.hpp>
 
+#include "manager.hpp"
+
 namespace Fleet::Core::Graphics {
 
     VertexArray::VertexArray() {
@@ -32,14 +34,15 @@ namespace Fleet::Core::Graphics {
         glad_glCreateVertexArrays(1, &vtxaobj);
     }
     VertexArray::~VertexArray() {
+        Manager::ForgetVertexArray(vtxaobj);
         glad_glDeleteVertexArrays(1, &vtxaobj);
     }
 
     void VertexArray::Bind() const {
-        glad_glBindVertexArray(vtxaobj);
+        Manager::BindVertexArray(vtxaobj);
     }
     void VertexArray::Unbind() const {
-        glad_glBindVertexArray(0);
+        Manager::BindVertexArray(0);
     }
 
     void VertexArray::AddVertexBuffer(const std::shared_ptr<VertexBuffer>& vtxBuffer) {
@@ -49,7 +52,7 @@ namespace Fleet::Core::Graphics {
             return;
         }
 
-        glad_glBindVertexArray(vtxaobj);
+        Manager::BindVertexArray(vtxaobj);
         vtxBuffer->Bind();
 
         const auto& layout = vtxBuffer->GetLayout();
@@ -57,8 +60,14 @@ namespace Fleet::Core::Graphics {
         for (const auto& element : layout) {
 
             glad_glEnableVertexAttribArray(VertexBufferIndex);
-            glad_glVertexAttribPointer(VertexBufferIndex, element.GetComponentCount(), ShaderTypeToGLBaseType(element.type),
-                                       element.normalized ? GL_TRUE : GL_FALSE, layout.GetStride(), reinterpret_cast<const void*>(element.offset));
+
+            // Integer attributes reach the shader as integers unless they are normalized
+            if (ShaderTypeToGLBaseType(element.type) == GL_INT && !element.normalized)
+                glad_glVertexAttribIPointer(VertexBufferIndex, element.GetComponentCount(), GL_INT, layout.GetStride(), reinterpret_cast<const void*>(element.offset));
+            else
+                glad_glVertexAttribPointer(VertexBufferIndex, element.GetComponentCount(), ShaderTypeToGLBaseType(element.type),
+                                           element.normalized ? GL_TRUE : GL_FALSE, layout.GetStride(), reinterpret_cast<const void*>(element.offset));
+            glad_glVertexAttribDivisor(VertexBufferIndex, element.divisor);
             VertexBufferIndex++;
         }
 
@@ -67,7 +76,7 @@ namespace Fleet::Core::Graphics {
 
     void VertexArray::SetIndexBuffer(const std::shared_ptr<Fleet::Core::Graphics::IndexBuffer>& idxBuffer) {
 
-        glad_glBindVertexArray(vtxaobj);
+        Manager::BindVertexArray(vtxaobj);
         idxBuffer->Bind();
 
         ptrIndexBuffer = idxBuffer;
@@ -29,6 +29,7 @@
 // Include standard library
 #include <vector>
 #include <memory>
+#include <cstdint>
 
 // Include Fleet libraries
 #include "buffer.hpp"
@@ -40,6 +41,23 @@ namespace Fleet::Core::Graphics {
         glm::vec2 texcoord;
         glm::vec4 color;
         float texslot;
+        float mode;                 // How the texture is sampled, see Renderer::SAMPLE_MODE ("uber" shader)
+    };
+
+    struct SpriteInstance {         // One record per sprite, expanded to a quad in the vertex shader
+        glm::vec3 position;
+        glm::vec2 size;
+        float rotation;             // in degrees
+        glm::vec4 color;
+        glm::vec4 texrect;          // { u0, v0, u1, v1 }
+        float texslot;
+    };
+
+    struct GlyphInstance {          // One record per glyph, expanded to a quad from the font's glyph table ("text_gpu" shader)
+        glm::vec3 pen;              // Baseline origin of the glyph
+        int32_t glyph;              // Index into the font's glyph table
+        uint32_t color;             // RGBA8
+        uint32_t scale;             // Two half floats
     };
 
     class VertexArray {
@@ -27,8 +27,7 @@
 #include <atomic>
 #include <chrono>
 #include <thread>
-#include <sstream>
-#include <iomanip>
+#include <cstdio>
 
 // Include dependencies
 #include <GLM/glm/gtc/matrix_transform.hpp>
@@ -53,7 +52,14 @@ namespace Fleet::Core {
         //shutdown();
     }
 
-    int Manager::init() {
+    int Manager::init(bool _headless) {
+
+        if (_headless) {
+
+            engine.metadata.vidmode = Engine::Metadata::VideoMode::WINDOWED;
+            engine.metadata.enableVSync = false;
+            engine.metadata.windowHints.push_back(std::make_pair(GLFW_VISIBLE, GLFW_FALSE));
+        }
 
         // Initialize the game engine
         if (engine.init() != 0) {
@@ -73,6 +79,12 @@ namespace Fleet::Core {
         // Initialize 2d renderer
         Graphics::Renderer::init(engine.GetWindowDimensions(), engine.GetMaxTextureUnits());
 
+        // Create sprite atlas
+        TextureAtlas = std::make_unique<Graphics::TextureAtlas>();
+
+        // Create texture arrays (size class grouped, used by the "array" and "sprite_array" shaders)
+        TextureArrays = std::make_unique<Graphics::TextureArrayLibrary>();
+
         // Set default camera ortho to fit window dimensions
         DefaultCameraOrtho = glm::ortho(-engine.GetWindowDimensions().x / 2.f, engine.GetWindowDimensions().x / 2.f,
                                         -engine.GetWindowDimensions().y / 2.f, engine.GetWindowDimensions().y / 2.f);
@@ -88,8 +100,9 @@ namespace Fleet::Core {
         for (auto const& [key, val] : cameras)
             val->SetLock(true);
 
-        // Create default fonts
-        FontLibrary.insert({ "nsjpl", std::make_unique<Graphics::FontLibrary>("nsjpl", "assets/fonts/nsjpl.otf") });
+        // Create default fonts (SDF where FreeType supports it, every size shares one atlas)
+        Graphics::FontMode DefaultFontMode = FLEET_FREETYPE_SDF ? Graphics::FontMode::SDF : Graphics::FontMode::BITMAP;
+        FontLibrary.insert({ "nsjpl", std::make_unique<Graphics::FontLibrary>("nsjpl", "assets/fonts/nsjpl.otf", DefaultFontMode) });
         FontLibrary["nsjpl"]->AddSize(32);
         FontLibrary["nsjpl"]->AddSize(56);
 
@@ -137,12 +150,12 @@ namespace Fleet::Core {
     }
 
     std::string Manager::ft_str() {
-        
-        std::stringstream oss;
 
-        oss << std::fixed << std::setprecision(2) << _fps.GetFT();
+        // Formatted on the stack, the result fits the small string buffer
+        char buffer[16];
+        std::snprintf(buffer, sizeof(buffer), "%.2fms", _fps.GetFT());
 
-        return oss.str() + "ms";
+        return buffer;
     }
 
     const std::unique_ptr<Graphics::OrthoCam>& Manager::GetCamera(const std::string& _name) {
@@ -152,6 +165,19 @@ namespace Fleet::Core {
         return FontLibrary[_name]->GetFont(_size);
     }
 
+    const std::unique_ptr<Graphics::TextureAtlas>& Manager::GetTextureAtlas() const {
+        return TextureAtlas;
+    }
+    const std::unique_ptr<Graphics::TextureArrayLibrary>& Manager::GetTextureArrays() const {
+        return TextureArrays;
+    }
+    const Graphics::Statistics::FrameStatistics& Manager::GetRenderStatistics() const {
+        return Graphics::Statistics::GetLastFrame();
+    }
+    const Graphics::Profiler::FrameTiming& Manager::GetGPUTimings() const {
+        return Graphics::Profiler::GetLastFrame();
+    }
+
     const glm::vec2& Manager::GetWindowDimensions() const {
         return engine.GetWindowDimensions();
     }
@@ -38,6 +38,10 @@
 // Include boomerang libraries
 #include "engine.hpp"
 #include "graphics/font.hpp"
+#include "graphics/atlas.hpp"
+#include "graphics/texturearray.hpp"
+#include "graphics/statistics.hpp"
+#include "graphics/profiler.hpp"
 #include "graphics/camera/orthocam.hpp"
 
 namespace Fleet::Core {
@@ -53,7 +57,7 @@ namespace Fleet::Core {
         Manager();
         ~Manager();
 
-        int init();
+        int init(bool _headless = false);          // Headless creates an invisible window (benchmarks, CI)
         void shutdown();
 
         enum class GAME_STATE {
@@ -73,6 +77,10 @@ namespace Fleet::Core {
 
         const std::unique_ptr<Graphics::OrthoCam>& GetCamera(const std::string& _name);
         const std::shared_ptr<Graphics::Font>& GetFont(const std::string& _name, int _size);
+        const std::unique_ptr<Graphics::TextureAtlas>& GetTextureAtlas() const;
+        const std::unique_ptr<Graphics::TextureArrayLibrary>& GetTextureArrays() const;
+        const Graphics::Statistics::FrameStatistics& GetRenderStatistics() const;      // Last completed frame
+        const Graphics::Profiler::FrameTiming& GetGPUTimings() const;                   // Lags a few frames behind
         
         const glm::vec2& GetWindowDimensions() const;
         GLFWwindow* GetWindow();
@@ -84,6 +92,8 @@ namespace Fleet::Core {
         glm::mat4 DefaultCameraOrtho;
         std::map<std::string, std::unique_ptr<Graphics::OrthoCam>> cameras;
         std::map<std::string, std::unique_ptr<Graphics::FontLibrary>> FontLibrary;
+        std::unique_ptr<Graphics::TextureAtlas> TextureAtlas;
+        std::unique_ptr<Graphics::TextureArrayLibrary> TextureArrays;
 
         ASWL::Timers::DeltaTime DeltaTime;
         ASWL::Timers::FramesPerSecond _fps;
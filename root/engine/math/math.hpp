@@ -27,6 +27,8 @@
 #define FLEET_ENGINE_MATH_MATH
 
 // Include standard library
+#include <cmath>
+#include <array>
 #include <vector>
 #include <random>
 #include <functional>
@@ -56,6 +58,30 @@ namespace Fleet::Core::Math {
 
     const glm::vec3 RotatePoint(const glm::vec3& point, const glm::vec3& pivot, float rotation, AngleType type = AngleType::DEGREES);
 
+    // Rotate a fixed set of points around the same pivot, sharing one sin/cos evaluation
+    template<size_t N>
+    std::array<glm::vec3, N> RotatePoints(const std::array<glm::vec3, N>& points, const glm::vec3& pivot, float rotation, AngleType type = AngleType::DEGREES) {
+
+        if (type == AngleType::DEGREES)
+            rotation = ConvertToRadians<float>(rotation);
+
+        float sin_r = std::sin(rotation);
+        float cos_r = std::cos(rotation);
+
+        std::array<glm::vec3, N> rotated = points;
+
+        for (auto& p : rotated) {
+
+            float x = p.x - pivot.x;
+            float y = p.y - pivot.y;
+
+            p.x = (x * cos_r) - (y * sin_r) + pivot.x;
+            p.y = (x * sin_r) + (y * cos_r) + pivot.y;
+        }
+
+        return rotated;
+    }
+
     const float SmoothNoise2D(float x, float y, std::function<float(int, int)> Noise2D);
     const float Interpolate2D(float x, float y, std::function<float(int, int)> Noise2D);
     const float Interpolate(float a, float b, float x);
@@ -24,7 +24,7 @@
 #include "collision.hpp"
 
 // Include standard library
-#include <vector>
+#include <array>
 #include <algorithm>
 
 // Include dependencies
@@ -53,11 +53,7 @@ namespace Fleet::Core::Physics {
         float bMax = 0;
         float bMin = 0;
 
-        std::vector<glm::vec3> axes;
-        axes.push_back(aUR - aUL);
-        axes.push_back(aUR - aLR);
-        axes.push_back(bUL - bLL);
-        axes.push_back(bUL - bUR);
+        std::array<glm::vec3, 4> axes = { aUR - aUL, aUR - aLR, bUL - bLL, bUL - bUR };
 
         for (auto& axis : axes) {
 
@@ -71,19 +67,11 @@ namespace Fleet::Core::Physics {
             glm::vec3 bURProject = glm::proj(bUR, axis);
             glm::vec3 bLRProject = glm::proj(bLR, axis);
 
-            std::vector<float> aDots;
-            aDots.push_back(glm::dot(aULProject, axis));
-            aDots.push_back(glm::dot(aLLProject, axis));
-            aDots.push_back(glm::dot(aURProject, axis));
-            aDots.push_back(glm::dot(aLRProject, axis));
+            std::array<float, 4> aDots = { glm::dot(aULProject, axis), glm::dot(aLLProject, axis), glm::dot(aURProject, axis), glm::dot(aLRProject, axis) };
             aMax = *std::max_element(aDots.begin(), aDots.end());
             aMin = *std::min_element(aDots.begin(), aDots.end());
 
-            std::vector<float> bDots;
-            bDots.push_back(glm::dot(bULProject, axis));
-            bDots.push_back(glm::dot(bLLProject, axis));
-            bDots.push_back(glm::dot(bURProject, axis));
-            bDots.push_back(glm::dot(bLRProject, axis));
+            std::array<float, 4> bDots = { glm::dot(bULProject, axis), glm::dot(bLLProject, axis), glm::dot(bURProject, axis), glm::dot(bLRProject, axis) };
             bMax = *std::max_element(bDots.begin(), bDots.end());
             bMin = *std::min_element(bDots.begin(), bDots.end());
 
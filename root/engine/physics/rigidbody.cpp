@@ -53,11 +53,7 @@ namespace Fleet::Core::Physics {
 
         if (LastRotation != _rotation) {
 
-            vt.UpperLeftVertex = Math::RotatePoint(vt.UpperLeftVertex, position, _rotation - LastRotation);
-            vt.LowerLeftVertex = Math::RotatePoint(vt.LowerLeftVertex, position, _rotation - LastRotation);
-            vt.UpperRightVertex = Math::RotatePoint(vt.UpperRightVertex, position, _rotation - LastRotation);
-            vt.LowerRightVertex = Math::RotatePoint(vt.LowerRightVertex, position, _rotation - LastRotation);
-
+            RotateVertices(_rotation - LastRotation);
             LastRotation = _rotation;
         }
     }
@@ -74,10 +70,17 @@ namespace Fleet::Core::Physics {
         vt.UpperRightVertex = glm::vec3(position.x + ((size.x * scale.x) / 2.f), position.y + ((size.y * scale.y) / 2.f), 0);;
         vt.LowerRightVertex = glm::vec3(position.x + ((size.x * scale.x) / 2.f), position.y - ((size.y * scale.y) / 2.f), 0);;
 
-        vt.UpperLeftVertex = Math::RotatePoint(vt.UpperLeftVertex, position, LastRotation);
-        vt.LowerLeftVertex = Math::RotatePoint(vt.LowerLeftVertex, position, LastRotation);
-        vt.UpperRightVertex = Math::RotatePoint(vt.UpperRightVertex, position, LastRotation);
-        vt.LowerRightVertex = Math::RotatePoint(vt.LowerRightVertex, position, LastRotation);
+        RotateVertices(LastRotation);
+    }
+
+    void Rigidbody::RotateVertices(float _rotation) {
+
+        auto rotated = Math::RotatePoints<4>({ vt.UpperLeftVertex, vt.LowerLeftVertex, vt.UpperRightVertex, vt.LowerRightVertex }, position, _rotation);
+
+        vt.UpperLeftVertex = rotated[0];
+        vt.LowerLeftVertex = rotated[1];
+        vt.UpperRightVertex = rotated[2];
+        vt.LowerRightVertex = rotated[3];
     }
 
 
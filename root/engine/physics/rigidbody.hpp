@@ -69,6 +69,7 @@ namespace Fleet::Core::Physics {
 
         void update(const glm::vec3& _position, float _rotation);
         void UpdateVertices();
+        void RotateVertices(float _rotation);   // Rotates vt around position
         
         // Setters
         void SetSize(const glm::vec2& _size);
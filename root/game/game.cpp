@@ -0,0 +1,72 @@
+// Fleet : game/game.cpp (c) 2021 Andrew Woo
+
+/* Modified MIT License
+ *
+ * Copyright 2021 Andrew Woo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * Restrictions:
+ >  The Software may not be sold unless significant, mechanics changing modifications are made by the seller, or unless the buyer
+ >  understands an unmodified version of the Software is available elsewhere free of charge, and agrees to buy the Software given
+ >  this knowledge.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "game.hpp"
+
+// Include standard library
+#include <string>
+
+// Include Fleet libraries
+#include "../engine/graphics/renderer.hpp"
+
+using namespace Fleet::Core::Graphics::Renderer::RENDER_LAYER;
+
+namespace Fleet {
+
+    Game::Game(Core::Manager& _manager) 
+        : manager(_manager),
+          tFlagship(std::make_shared<Core::Graphics::Texture>("assets/boat1.png")),
+          flagship({ 0.f, 0.f, 0.f }, { 0.5f, 0.5f }, glm::vec4(1.f), tFlagship),
+          version(Core::BUILD_VERSION, { { 0, 290, LAYER1 }, { 1.f, 1.f }, glm::vec4(1.f) }, _manager.GetFont("nsjpl", 25)) {
+
+        manager.GetCamera("main_0")->SetLock(false);
+        manager.GetCamera("main_0")->SetSpeed(0);
+    }
+
+    void Game::frame() {
+
+        namespace Renderer = Core::Graphics::Renderer;
+
+        manager.GetCamera("main_0")->SetPosition(flagship.GetPosition());
+
+        flagship.update(manager.dt());
+
+        // Ships and their labels share one batch
+        glm::vec3 label = flagship.GetPosition() + glm::vec3(0.f, tFlagship->GetDimensions().y * flagship.GetSize().y / 2.f + 20.f, LAYER1);
+
+        Renderer::StartScene(manager.GetCamera("main_0"), "uber");
+        Renderer::RenderTexture({ flagship.GetPosition(), flagship.GetSize(), glm::vec4(1.f), flagship.GetRotation() }, tFlagship);
+        Renderer::RenderText("Flagship", { label, { 1.f, 1.f }, glm::vec4(1.f) }, manager.GetFont("nsjpl", 25));
+        Renderer::EndScene();
+
+        Renderer::StartScene(manager.GetCamera("grid_0"), "grid");
+        Renderer::RenderGrid(manager.GetCamera("main_0")->GetPosition(), 40);
+        Renderer::EndScene();
+
+        Renderer::StartScene(manager.GetCamera("text_0"), "uber");
+        Renderer::RenderStaticText(version);
+        Renderer::RenderText(manager.ft_str(), { { 820, 520, LAYER1 }, { 1.f, 1.f }, {0.f, 1.f, 0.f, 1.f} }, manager.GetFont("nsjpl", 32));
+        Renderer::RenderText(std::to_string((int)manager.fps()), { { 920, 520, LAYER1 }, { 1.f, 1.f }, {0.f, 1.f, 0.f, 1.f} }, manager.GetFont("nsjpl", 32));
+        Renderer::EndScene();
+    }
+}
@@ -0,0 +1,64 @@
+// Fleet : game/game.hpp (c) 2021 Andrew Woo
+
+/* Modified MIT License
+ *
+ * Copyright 2021 Andrew Woo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * Restrictions:
+ >  The Software may not be sold unless significant, mechanics changing modifications are made by the seller, or unless the buyer
+ >  understands an unmodified version of the Software is available elsewhere free of charge, and agrees to buy the Software given
+ >  this knowledge.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#ifndef FLEET_GAME
+#define FLEET_GAME
+
+// Include standard library
+#include <memory>
+
+// Include Fleet libraries
+#include "../engine/manager.hpp"
+#include "../engine/graphics/texture.hpp"
+#include "../engine/graphics/text.hpp"
+#include "../objects/flagship.hpp"
+
+namespace Fleet {
+
+    class Game {
+
+        /// Game state and the per frame work of main.cpp's loop. fleet_bench drives the same frame, so its
+        /// allocation check covers the real loop and not a copy of it.
+
+    public:
+
+        Game(Core::Manager& _manager);
+
+        // Update and render one frame, between Graphics::Manager::BeginRender and EndRender
+        void frame();
+
+    private:
+
+        Core::Manager& manager;
+
+        std::shared_ptr<Core::Graphics::Texture> tFlagship;
+        Objects::Flagship flagship;
+
+        // Never changes, built once and drawn from its own vertex buffer
+        Core::Graphics::StaticText version;
+    };
+}
+
+#endif // !FLEET_GAME
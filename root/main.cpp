@@ -28,16 +28,13 @@
 #include "engine/manager.hpp"
 
 #include "engine/graphics/manager.hpp"
-#include "engine/graphics/renderer.hpp"
 
-// Objects
-#include "objects/flagship.hpp"
+// Game
+#include "game/game.hpp"
 
 // Dependencies
 #include <ASWL/logger.hpp>
 
-using namespace Fleet::Core::Graphics::Renderer::RENDER_LAYER;
-
 int main(int argc, char* argv[]) {
 
     ASWL::Logger::logger("     ", "Hello, Fleet!");
@@ -51,35 +48,14 @@ int main(int argc, char* argv[]) {
         return ret;
     }
 
-    std::shared_ptr<Fleet::Core::Graphics::Texture> tFlagship = std::make_shared<Fleet::Core::Graphics::Texture>("assets/boat1.png");
-    Fleet::Objects::Flagship flagship( { 0.f, 0.f, 0.f }, { 0.5f, 0.5f }, glm::vec4(1.f), tFlagship);
-
-    manager.GetCamera("main_0")->SetLock(false);
-    manager.GetCamera("main_0")->SetSpeed(0);
+    Fleet::Game game(manager);
 
     while (manager.run()) {
 
         manager.update();
-        manager.GetCamera("main_0")->SetPosition(flagship.GetPosition());
-
-        flagship.update(manager.dt());
 
         Fleet::Core::Graphics::Manager::BeginRender();
-
-        Fleet::Core::Graphics::Renderer::StartScene(manager.GetCamera("main_0"));
-        Fleet::Core::Graphics::Renderer::RenderTexture({ flagship.GetPosition(), flagship.GetSize(), glm::vec4(1.f), flagship.GetRotation() }, tFlagship);
-        Fleet::Core::Graphics::Renderer::EndScene();
-
-        Fleet::Core::Graphics::Renderer::StartScene(manager.GetCamera("grid_0"), "grid");
-        Fleet::Core::Graphics::Renderer::RenderGrid(manager.GetCamera("main_0")->GetPosition(), 40);
-        Fleet::Core::Graphics::Renderer::EndScene();
-        
-        Fleet::Core::Graphics::Renderer::StartScene(manager.GetCamera("text_0"), "text");
-        Fleet::Core::Graphics::Renderer::RenderText(Fleet::Core::BUILD_VERSION, { { 0, 290, LAYER1 }, { 1.f, 1.f }, glm::vec4(1.f) }, manager.GetFont("nsjpl", 25));
-        Fleet::Core::Graphics::Renderer::RenderText(manager.ft_str(), { { 820, 520, LAYER1 }, { 1.f, 1.f }, {0.f, 1.f, 0.f, 1.f} }, manager.GetFont("nsjpl", 32));
-        Fleet::Core::Graphics::Renderer::RenderText(std::to_string((int)manager.fps()), { { 920, 520, LAYER1 }, { 1.f, 1.f }, {0.f, 1.f, 0.f, 1.f} }, manager.GetFont("nsjpl", 32));
-        Fleet::Core::Graphics::Renderer::EndScene();
-
+        game.frame();
         Fleet::Core::Graphics::Manager::EndRender(manager.GetWindow());
     }
 